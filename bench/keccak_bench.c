@@ -0,0 +1,104 @@
+/** @file keccak_bench.c
+ *  @brief Measures the cost of one Keccak-f[1600] permutation for each of the
+ *         available implementations and backends.
+ *
+ *  On x86 the cost is given in time stamp counter cycles, on other hosts in
+ *  nanoseconds. Usage: keccak_bench [NUM_PERMUTATIONS]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "iota/dispatch.h"
+#include "keccak/sha3.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define UNIT "cycles"
+
+static uint64_t timestamp(void)
+{
+    return __rdtsc();
+}
+#else
+#include <time.h>
+#define UNIT "ns"
+
+static uint64_t timestamp(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+#endif
+
+#define NUM_RUNS 5
+
+/** @brief Returns the best time of several runs per single permutation.
+ *  @param permutation function permuting the given interleaved states
+ *  @param lanes number of states permuted by one call
+ *  @param num number of calls per run
+ */
+static double measure(void (*permutation)(uint64_t *), unsigned int lanes,
+                      unsigned int num)
+{
+    uint64_t state[25 * 8];
+    memset(state, 0, sizeof(state));
+
+    // warm up caches and branch predictors
+    for (unsigned int i = 0; i < num / 10; i++) {
+        permutation(state);
+    }
+
+    uint64_t best = UINT64_MAX;
+    for (unsigned int run = 0; run < NUM_RUNS; run++) {
+        const uint64_t start = timestamp();
+        for (unsigned int i = 0; i < num; i++) {
+            permutation(state);
+        }
+        const uint64_t elapsed = timestamp() - start;
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    // use the state so that the permutations cannot be optimized away
+    if (state[0] == 0x0123456789abcdef) {
+        printf("\n");
+    }
+
+    return (double)best / num / lanes;
+}
+
+int main(int argc, char *argv[])
+{
+    const unsigned int num = argc > 1 ? (unsigned int)atoi(argv[1]) : 100000;
+
+    const double compact = measure(sha3_permutation_compact, 1, num);
+    const double unrolled = measure(sha3_permutation_unrolled, 1, num);
+
+    printf("compact:       %8.1f %s/permutation\n", compact, UNIT);
+    printf("unrolled:      %8.1f %s/permutation (%.2fx)\n", unrolled, UNIT,
+           compact / unrolled);
+    printf("interleaved32: %8.1f %s/permutation\n",
+           measure(sha3_permutation_interleaved32, 1, num), UNIT);
+
+    static const char *const BACKENDS[] = {"generic", "avx2", "avx512"};
+    for (unsigned int i = 0; i < sizeof(BACKENDS) / sizeof(BACKENDS[0]); i++) {
+        if (!dispatch_select(BACKENDS[i])) {
+            printf("%s: not supported\n", BACKENDS[i]);
+            continue;
+        }
+        printf("%s:\n", BACKENDS[i]);
+        printf("  x1:          %8.1f %s/permutation\n",
+               measure(dispatch->keccak_permutation, 1, num), UNIT);
+        printf("  x2:          %8.1f %s/permutation\n",
+               measure(dispatch->keccak_permutation_x2, 2, num / 2), UNIT);
+        printf("  x4:          %8.1f %s/permutation\n",
+               measure(dispatch->keccak_permutation_x4, 4, num / 4), UNIT);
+        printf("  x8:          %8.1f %s/permutation\n",
+               measure(dispatch->keccak_permutation_x8, 8, num / 8), UNIT);
+    }
+
+    return 0;
+}
@@ -1,20 +1,13 @@
 #include "aux.h"
 #include <string.h>
 #include "iota/common.h"
+#include "iota/dispatch.h"
 
 #define PAD_CHAR '9'
 
 bool validate_chars(const char *chars, unsigned int num_chars)
 {
-    const size_t len = strnlen(chars, num_chars);
-    for (unsigned int i = 0; i < len; i++) {
-        const char c = chars[i];
-        if (c != '9' && (c < 'A' || c > 'Z')) {
-            return false;
-        }
-    }
-
-    return true;
+    return dispatch->validate_chars(chars, strnlen(chars, num_chars));
 }
 
 void rpad_chars(char *destination, const char *source, unsigned int num_chars)
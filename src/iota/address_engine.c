@@ -0,0 +1,125 @@
+#include "address_engine.h"
+#include "addresses.h"
+#include "common.h"
+
+/** @brief Returns whether the next chunk can be claimed.
+ *  A chunk is only handed out when its slots in the ring are free, so that
+ *  the lowest outstanding chunk can always be claimed and completed.
+ */
+static bool chunk_available(const ADDRESS_ENGINE *engine, unsigned int n)
+{
+    return engine->claimed + n <= engine->consumed + ADDRESS_ENGINE_RING_SIZE;
+}
+
+static void *address_engine_worker(void *arg)
+{
+    ADDRESS_ENGINE *engine = arg;
+    unsigned char addresses[ADDRESS_ENGINE_CHUNK * NUM_HASH_BYTES];
+
+    pthread_mutex_lock(&engine->lock);
+    while (!engine->stop && engine->claimed < engine->count) {
+        const unsigned int first = engine->claimed;
+        const unsigned int n =
+            MIN(engine->count - first, ADDRESS_ENGINE_CHUNK);
+
+        if (!chunk_available(engine, n)) {
+            pthread_cond_wait(&engine->space, &engine->lock);
+            continue;
+        }
+        engine->claimed += n;
+
+        // the addresses are computed without holding the lock
+        pthread_mutex_unlock(&engine->lock);
+        get_public_addrs(engine->seed_bytes, engine->start + first, n,
+                         engine->security, addresses);
+        pthread_mutex_lock(&engine->lock);
+
+        for (unsigned int i = 0; i < n; i++) {
+            const unsigned int slot = (first + i) % ADDRESS_ENGINE_RING_SIZE;
+            os_memcpy(engine->ring[slot], addresses + i * NUM_HASH_BYTES,
+                      NUM_HASH_BYTES);
+            engine->filled[slot] = true;
+        }
+        pthread_cond_signal(&engine->ready);
+    }
+    pthread_mutex_unlock(&engine->lock);
+
+    return NULL;
+}
+
+int address_engine_start(ADDRESS_ENGINE *engine,
+                         const unsigned char *seed_bytes, uint32_t start,
+                         unsigned int count, unsigned int security,
+                         unsigned int num_threads)
+{
+    if (!IN_RANGE(security, MIN_SECURITY_LEVEL, MAX_SECURITY_LEVEL) ||
+        !IN_RANGE(num_threads, 1, ADDRESS_ENGINE_MAX_THREADS)) {
+        return -1;
+    }
+
+    os_memcpy(engine->seed_bytes, seed_bytes, NUM_HASH_BYTES);
+    engine->start = start;
+    engine->count = count;
+    engine->security = security;
+
+    engine->claimed = 0;
+    engine->consumed = 0;
+    engine->stop = false;
+    os_memset(engine->filled, 0, sizeof(engine->filled));
+
+    pthread_mutex_init(&engine->lock, NULL);
+    pthread_cond_init(&engine->space, NULL);
+    pthread_cond_init(&engine->ready, NULL);
+
+    for (engine->num_threads = 0; engine->num_threads < num_threads;
+         engine->num_threads++) {
+        if (pthread_create(&engine->threads[engine->num_threads], NULL,
+                           address_engine_worker, engine) != 0) {
+            address_engine_stop(engine);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+bool address_engine_next(ADDRESS_ENGINE *engine, unsigned char *address_bytes)
+{
+    pthread_mutex_lock(&engine->lock);
+    if (engine->consumed >= engine->count) {
+        pthread_mutex_unlock(&engine->lock);
+        return false;
+    }
+
+    const unsigned int slot = engine->consumed % ADDRESS_ENGINE_RING_SIZE;
+    while (!engine->filled[slot]) {
+        pthread_cond_wait(&engine->ready, &engine->lock);
+    }
+
+    os_memcpy(address_bytes, engine->ring[slot], NUM_HASH_BYTES);
+    engine->filled[slot] = false;
+    engine->consumed++;
+
+    // wake up all waiting workers, as any of them can claim the next chunk
+    pthread_cond_broadcast(&engine->space);
+    pthread_mutex_unlock(&engine->lock);
+
+    return true;
+}
+
+void address_engine_stop(ADDRESS_ENGINE *engine)
+{
+    pthread_mutex_lock(&engine->lock);
+    engine->stop = true;
+    pthread_cond_broadcast(&engine->space);
+    pthread_mutex_unlock(&engine->lock);
+
+    for (unsigned int i = 0; i < engine->num_threads; i++) {
+        pthread_join(engine->threads[i], NULL);
+    }
+    engine->num_threads = 0;
+
+    pthread_cond_destroy(&engine->ready);
+    pthread_cond_destroy(&engine->space);
+    pthread_mutex_destroy(&engine->lock);
+}
@@ -0,0 +1,90 @@
+/** @file address_engine.h
+ *  @brief Parallel generation of address ranges with ordered output.
+ *
+ *  The engine computes the addresses of a range of indices on several
+ *  threads. Idle threads take the next chunk of indices that is not claimed
+ *  yet, so that the load is balanced between them. The results are delivered
+ *  in index order through a ring buffer of fixed size, which also limits how
+ *  far generation can run ahead of the consumer.
+ */
+
+#ifndef ADDRESS_ENGINE_H
+#define ADDRESS_ENGINE_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include "iota_types.h"
+
+// maximum number of worker threads of one engine
+#define ADDRESS_ENGINE_MAX_THREADS 64
+
+// number of addresses buffered in the ring, must be at least
+// ADDRESS_ENGINE_CHUNK
+#define ADDRESS_ENGINE_RING_SIZE 256
+
+// number of consecutive indices computed by a worker at once, so that
+// get_public_addrs() can compute them all in lockstep
+#define ADDRESS_ENGINE_CHUNK 8
+
+typedef struct ADDRESS_ENGINE {
+        unsigned char seed_bytes[48];
+        uint32_t start;
+        unsigned int count;
+        unsigned int security;
+
+        pthread_t threads[ADDRESS_ENGINE_MAX_THREADS];
+        unsigned int num_threads;
+
+        // protects all of the following fields
+        pthread_mutex_t lock;
+        // signaled when the consumer frees slots of the ring
+        pthread_cond_t space;
+        // signaled when a worker completes a chunk
+        pthread_cond_t ready;
+
+        unsigned int claimed;  // number of addresses handed out to workers
+        unsigned int consumed; // number of addresses read by the consumer
+        bool stop;
+
+        // address start + i is stored in slot i % ADDRESS_ENGINE_RING_SIZE
+        unsigned char ring[ADDRESS_ENGINE_RING_SIZE][48];
+        bool filled[ADDRESS_ENGINE_RING_SIZE];
+} ADDRESS_ENGINE;
+
+/** @brief Starts the parallel generation of a range of addresses.
+ *  The addresses are identical to those of get_public_addr() for the indices
+ *  start to start + count - 1.
+ *  @param engine the engine context used
+ *  @param seed_bytes seed in 48-byte big endian encoding
+ *  @param start index of the first address
+ *  @param count number of addresses
+ *  @param security security level of the addresses
+ *  @param num_threads number of worker threads, at most
+ *         ADDRESS_ENGINE_MAX_THREADS
+ *  @return 0, or -1 if a parameter is invalid or the threads could not be
+ *          created
+ */
+int address_engine_start(ADDRESS_ENGINE *engine,
+                         const unsigned char *seed_bytes, uint32_t start,
+                         unsigned int count, unsigned int security,
+                         unsigned int num_threads);
+
+/** @brief Returns the next address in index order.
+ *  This blocks until the address is computed. It must only be called by one
+ *  thread at a time.
+ *  @param engine the engine context used
+ *  @param address_bytes target 48-byte address
+ *  @return true, if an address was returned, false if all addresses of the
+ *          range have already been returned
+ */
+bool address_engine_next(ADDRESS_ENGINE *engine, unsigned char *address_bytes);
+
+/** @brief Stops the generation and releases the threads.
+ *  This can be called before all addresses have been returned, in which case
+ *  the remaining ones are discarded. The engine can be started again
+ *  afterwards.
+ *  @param engine the engine context used
+ */
+void address_engine_stop(ADDRESS_ENGINE *engine);
+
+#endif // ADDRESS_ENGINE_H
@@ -1,42 +1,150 @@
 #include "addresses.h"
 #include "common.h"
 #include "conversion.h"
+#include "dispatch.h"
 #include "kerl.h"
 #include <string.h>
 
 #define CHECKSUM_CHARS 9
 
-static void digest_single_chunk(unsigned char *key_fragment,
-                                cx_sha3_t *digest_sha3, cx_sha3_t *round_sha3)
+// number of addresses computed together by get_public_addrs(), each lane of
+// the multi-lane Kerl contexts computing a different address
+#define ADDRESS_BATCH KERL_X8_LANES
+
+// number of private key fragments per security level
+#define KEY_FRAGMENTS 27
+
+// number of private key fragments whose hash chains are computed together
+#define FRAGMENT_GROUP KERL_X8_LANES
+
+// compute the hashed subseed of the given index
+static void get_subseed(const unsigned char *seed_bytes, uint32_t idx,
+                        unsigned char *subseed)
 {
-    for (int k = 0; k < 26; k++) {
-        kerl_initialize(round_sha3);
-        kerl_absorb_chunk(round_sha3, key_fragment);
-        kerl_squeeze_final_chunk(round_sha3, key_fragment);
-    }
+    // use temp bigint so seed not destroyed
+    os_memcpy(subseed, seed_bytes, NUM_HASH_BYTES);
 
-    // absorb buffer directly to avoid storing the digest fragment
-    kerl_absorb_chunk(digest_sha3, key_fragment);
+    bytes_add_u32_mem(subseed, idx);
+    kerl_hash_chunk(subseed, subseed);
 }
 
 // initialize the sha3 instance for generating private key
-static void init_shas(const unsigned char *seed_bytes, uint32_t idx,
-                      cx_sha3_t *key_sha, cx_sha3_t *digest_sha)
+static void init_shas(const unsigned char *subseed, KERL_CTX *key_sha,
+                      KERL_CTX *digest_sha)
 {
-    // use temp bigint so seed not destroyed
-    unsigned char bytes[NUM_HASH_BYTES];
-    os_memcpy(bytes, seed_bytes, sizeof(bytes));
+    kerl_initialize(key_sha);
+    kerl_absorb_chunk(key_sha, subseed);
 
-    bytes_add_u32_mem(bytes, idx);
+    kerl_initialize(digest_sha);
+}
 
-    kerl_initialize(key_sha);
-    kerl_absorb_chunk(key_sha, bytes);
-    kerl_squeeze_final_chunk(key_sha, bytes);
+// compute the digests of the first security levels of the private key
+// derived from the hashed subseed
+static void subseed_to_digests(const unsigned char *subseed,
+                               unsigned int security, unsigned char *digest)
+{
+    // Kerl context size is 208 bytes
+    KERL_CTX key_sha, digest_sha;
 
-    kerl_initialize(key_sha);
-    kerl_absorb_chunk(key_sha, bytes);
+    // init private key sha, digest sha
+    init_shas(subseed, &key_sha, &digest_sha);
 
-    kerl_initialize(digest_sha);
+    // only store one group of fragments of the private key at a time, whose
+    // hash chains are computed together
+    unsigned char key_f[FRAGMENT_GROUP * NUM_HASH_BYTES];
+
+    // the groups span the security levels, as the fragments of all levels
+    // are squeezed one after another
+    const unsigned int num_fragments = KEY_FRAGMENTS * security;
+    for (unsigned int f = 0; f < num_fragments; f += FRAGMENT_GROUP) {
+        const unsigned int n = MIN(num_fragments - f, FRAGMENT_GROUP);
+
+        for (unsigned int j = 0; j < n; j++) {
+            kerl_squeeze_chunk(&key_sha, key_f + j * NUM_HASH_BYTES);
+        }
+        kerl_chain_n(key_f, n, 26);
+
+        // absorb the results in the original order, completing the digest
+        // after the last fragment of each security level
+        for (unsigned int j = 0; j < n; j++) {
+            kerl_absorb_chunk(&digest_sha, key_f + j * NUM_HASH_BYTES);
+
+            if ((f + j) % KEY_FRAGMENTS == KEY_FRAGMENTS - 1) {
+                const unsigned int level = (f + j) / KEY_FRAGMENTS;
+                kerl_squeeze_final_chunk(&digest_sha,
+                                         digest + NUM_HASH_BYTES * level);
+
+                // reset digest sha for next digest
+                kerl_initialize(&digest_sha);
+            }
+        }
+    }
+}
+
+// generate public address in byte format from the digests of the security
+// levels
+static void digests_to_addr(const unsigned char *digest,
+                            unsigned int security, unsigned char *address_bytes)
+{
+    KERL_CTX digest_sha;
+    kerl_initialize(&digest_sha);
+
+    // absorb the digest for each security
+    kerl_absorb_bytes(&digest_sha, digest, NUM_HASH_BYTES * security);
+
+    // one final squeeze for address
+    kerl_squeeze_final_chunk(&digest_sha, address_bytes);
+}
+
+// generate public address in byte format from the hashed subseed
+static void subseed_to_addr(const unsigned char *subseed,
+                            unsigned int security, unsigned char *address_bytes)
+{
+    // buffer for the digests of each security level
+    unsigned char digest[NUM_HASH_BYTES * security];
+
+    subseed_to_digests(subseed, security, digest);
+    digests_to_addr(digest, security, address_bytes);
+}
+
+// same as subseed_to_addr for ADDRESS_BATCH hashed subseeds, all steps are
+// executed in lockstep for all of the addresses
+static void subseeds_to_addrs(const unsigned char *subseeds,
+                              unsigned int security,
+                              unsigned char *addresses_bytes)
+{
+    static const unsigned int num[ADDRESS_BATCH] = {26, 26, 26, 26,
+                                                    26, 26, 26, 26};
+
+    // lane j of the contexts belongs to address j
+    KERL_CTX_X8 key_sha, digest_sha;
+    kerl_initialize_x8(&key_sha);
+    kerl_absorb_chunk_x8(&key_sha, subseeds);
+    kerl_initialize_x8(&digest_sha);
+
+    // the digests of each security level for all of the addresses
+    unsigned char digests[MAX_SECURITY_LEVEL][ADDRESS_BATCH * NUM_HASH_BYTES];
+
+    // the current fragment of the private key of each address
+    unsigned char key_f[ADDRESS_BATCH * NUM_HASH_BYTES];
+
+    for (unsigned int i = 0; i < security; i++) {
+        for (unsigned int j = 0; j < KEY_FRAGMENTS; j++) {
+            kerl_squeeze_chunk_x8(&key_sha, key_f);
+            kerl_chain_x8(key_f, num);
+            kerl_absorb_chunk_x8(&digest_sha, key_f);
+        }
+        // this also resets digest sha for next digest
+        kerl_squeeze_final_chunk_x8(&digest_sha, digests[i]);
+    }
+
+    // absorb the digest for each security
+    for (unsigned int i = 0; i < security; i++) {
+        kerl_absorb_chunk_x8(&digest_sha, digests[i]);
+    }
+
+    // one final squeeze for the addresses
+    kerl_squeeze_final_chunk_x8(&digest_sha, addresses_bytes);
 }
 
 // generate public address in byte format
@@ -47,55 +155,87 @@ void get_public_addr(const unsigned char *seed_bytes, uint32_t idx,
         THROW(INVALID_PARAMETER);
     }
 
-    // sha size is 424 bytes
-    cx_sha3_t key_sha, digest_sha;
+    unsigned char subseed[NUM_HASH_BYTES];
+    get_subseed(seed_bytes, idx, subseed);
 
-    // init private key sha, digest sha
-    init_shas(seed_bytes, idx, &key_sha, &digest_sha);
+    subseed_to_addr(subseed, security, address_bytes);
+}
 
-    // buffer for the digests of each security level
-    unsigned char digest[NUM_HASH_BYTES * security];
+void get_public_addr_all_levels(const unsigned char *seed_bytes, uint32_t idx,
+                                unsigned char *addresses_bytes)
+{
+    unsigned char subseed[NUM_HASH_BYTES];
+    get_subseed(seed_bytes, idx, subseed);
 
-    // only store a single fragment of the private key at a time
-    // use last chunk of buffer, as this is only used after the key is generated
-    unsigned char *key_f = digest + NUM_HASH_BYTES * (security - 1);
+    // the digests of the lower levels are the first ones of the highest level
+    unsigned char digest[NUM_HASH_BYTES * MAX_SECURITY_LEVEL];
+    subseed_to_digests(subseed, MAX_SECURITY_LEVEL, digest);
 
-    for (uint8_t i = 0; i < security; i++) {
-        for (uint8_t j = 0; j < 27; j++) {
-            // use address output array as a temp Kerl state storage
-            unsigned char *state = address_bytes;
+    for (unsigned int security = MIN_SECURITY_LEVEL;
+         security <= MAX_SECURITY_LEVEL; security++) {
+        digests_to_addr(digest, security,
+                        addresses_bytes + (security - 1) * NUM_HASH_BYTES);
+    }
+}
 
-            // the state takes only 48bytes and allows us to reuse key_sha
-            kerl_state_squeeze_chunk(&key_sha, state, key_f);
-            // re-use key_sha as round_sha
-            digest_single_chunk(key_f, &digest_sha, &key_sha);
+void get_public_addrs(const unsigned char *seed_bytes, uint32_t start,
+                      unsigned int count, unsigned int security,
+                      unsigned char *addresses_bytes)
+{
+    if (!IN_RANGE(security, MIN_SECURITY_LEVEL, MAX_SECURITY_LEVEL)) {
+        THROW(INVALID_PARAMETER);
+    }
 
-            // as key_sha has been tainted, reinitialize with the saved state
-            kerl_reinitialize(&key_sha, state);
+    // seed plus the current index, which is incremented in place
+    unsigned char cursor[NUM_HASH_BYTES];
+    os_memcpy(cursor, seed_bytes, sizeof(cursor));
+    bytes_add_u32_mem(cursor, start);
+    uint32_t idx = start;
+
+    unsigned char subseeds[ADDRESS_BATCH * NUM_HASH_BYTES] = {0};
+
+    // computing the addresses in lockstep is only faster on backends which
+    // permute several states at once using SIMD, and for full batches
+    const bool lockstep = dispatch->keccak_lanes >= KERL_X4_LANES;
+
+    for (unsigned int i = 0; i < count; i += ADDRESS_BATCH) {
+        const unsigned int n = MIN(count - i, ADDRESS_BATCH);
+        unsigned int num[ADDRESS_BATCH] = {0};
+
+        for (unsigned int j = 0; j < n; j++) {
+            os_memcpy(subseeds + j * NUM_HASH_BYTES, cursor, NUM_HASH_BYTES);
+            num[j] = 1;
+
+            // the index wraps around just like in get_public_addr()
+            if (++idx == 0) {
+                os_memcpy(cursor, seed_bytes, sizeof(cursor));
+            }
+            else {
+                bytes_increment(cursor);
+            }
         }
-        kerl_squeeze_final_chunk(&digest_sha, digest + NUM_HASH_BYTES * i);
-
-        // reset digest sha for next digest
-        kerl_initialize(&digest_sha);
-    }
 
-    // absorb the digest for each security
-    kerl_absorb_bytes(&digest_sha, digest, NUM_HASH_BYTES * security);
+        // hash the subseeds of the whole batch at once
+        kerl_chain_x8(subseeds, num);
 
-    // one final squeeze for address
-    kerl_squeeze_final_chunk(&digest_sha, address_bytes);
+        if (lockstep && n == ADDRESS_BATCH) {
+            subseeds_to_addrs(subseeds, security,
+                              addresses_bytes + i * NUM_HASH_BYTES);
+            continue;
+        }
+        for (unsigned int j = 0; j < n; j++) {
+            subseed_to_addr(subseeds + j * NUM_HASH_BYTES, security,
+                            addresses_bytes + (i + j) * NUM_HASH_BYTES);
+        }
+    }
 }
 
 // get 9 character checksum of NUM_HASH_TRYTES character address
 void get_address_with_checksum(const unsigned char *address_bytes,
                                char *full_address)
 {
-    cx_sha3_t sha;
-    kerl_initialize(&sha);
-
     unsigned char checksum_bytes[NUM_HASH_BYTES];
-    kerl_absorb_chunk(&sha, address_bytes);
-    kerl_squeeze_final_chunk(&sha, checksum_bytes);
+    kerl_hash_chunk(address_bytes, checksum_bytes);
 
     char full_checksum[NUM_HASH_TRYTES];
     bytes_to_chars(checksum_bytes, full_checksum, NUM_HASH_BYTES);
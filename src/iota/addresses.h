@@ -6,6 +6,32 @@
 void get_public_addr(const unsigned char *seed_bytes, uint32_t idx,
                      unsigned int security, unsigned char *address_bytes);
 
+/** @brief Computes the addresses of all security levels of one index.
+ *  The private key of a lower security level is the beginning of the one of
+ *  a higher level, so that all addresses are computed at about the cost of
+ *  the one with the highest security level.
+ *  @param seed_bytes seed in 48-byte big endian encoding
+ *  @param idx address index
+ *  @param addresses_bytes target array of MAX_SECURITY_LEVEL 48-byte
+ *         addresses, the address of security level s being the s-th one
+ */
+void get_public_addr_all_levels(const unsigned char *seed_bytes, uint32_t idx,
+                                unsigned char *addresses_bytes);
+
+/** @brief Computes the addresses of a range of consecutive indices.
+ *  The result is identical to calling get_public_addr() for each index, but
+ *  the seed plus index is incremented in place instead of being recomputed,
+ *  and the subseeds are hashed in batches.
+ *  @param seed_bytes seed in 48-byte big endian encoding
+ *  @param start index of the first address
+ *  @param count number of addresses
+ *  @param security security level of the addresses
+ *  @param addresses_bytes target array of count 48-byte addresses
+ */
+void get_public_addrs(const unsigned char *seed_bytes, uint32_t start,
+                      unsigned int count, unsigned int security,
+                      unsigned char *addresses_bytes);
+
 /** @brief Computes the full address string in base-27 encoding.
  *  The full address consists of the actual address (81 chars) plus 9 chars of
  *  checksum.
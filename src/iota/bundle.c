@@ -250,7 +250,7 @@ static bool validate_bundle(const BUNDLE_CTX *ctx, unsigned int change_tx_index,
 
 static void compute_hash(BUNDLE_CTX *ctx)
 {
-    cx_sha3_t sha;
+    KERL_CTX sha;
 
     kerl_initialize(&sha);
     kerl_absorb_bytes(&sha, ctx->bytes, TX_BYTES(ctx) - ctx->bytes);
@@ -37,37 +37,6 @@
 
 #define os_memset memset
 
-/* ----------------------------------------------------------------------- */
-/* -                          CRYPTO FUNCTIONS                           - */
-/* ----------------------------------------------------------------------- */
-
-#define CX_LAST (1 << 0)
-
-typedef SHA3_CTX cx_sha3_t;
-typedef SHA3_CTX cx_hash_t;
-
-static inline void cx_keccak_init(SHA3_CTX* hash, int size) {
-        UNUSED(size);
-
-        keccak_384_Init(hash);
-}
-
-static inline void cx_hash(SHA3_CTX* hash, int mode, const unsigned char *in,
-                           unsigned int len, unsigned char *out) {
-
-        if (mode != CX_LAST) {
-                // if CX_LAST is not set, add input data to add to current hash
-                keccak_Update(hash, in, len);
-        } else if (len == 0) {
-                // if no input data given, compute and copy the hash
-                keccak_Final(hash, out);
-        } else {
-                // if CX_LAST is set, compute hash for input
-                keccak_Update(hash, in, len);
-                keccak_Final(hash, out);
-        }
-}
-
 /* ----------------------------------------------------------------------- */
 /* -                                 IO                                  - */
 /* ----------------------------------------------------------------------- */
@@ -1,34 +1,11 @@
 #include "conversion.h"
 #include <stdint.h>
 #include "common.h"
+#include "dispatch.h"
 
-// #define USE_UNSAFE_INCREMENT_TAG
-
-#define INT_LENGTH 12
 // base of the ternary system
 #define BASE 3
 
-// the middle of the domain described by 242 trits, i.e. \sum_{k=0}^{241} 3^k
-static const uint32_t HALF_3[12] = {
-    0xa5ce8964, 0x9f007669, 0x1484504f, 0x3ade00d9, 0x0c24486e, 0x50979d57,
-    0x79a4c702, 0x48bbae36, 0xa9f6808b, 0xaa06a805, 0xa87fabdf, 0x5e69ebef};
-
-// the two's complement of HALF_3_u, i.e. ~HALF_3_u + 1
-static const uint32_t NEG_HALF_3[12] = {
-    0x5a31769c, 0x60ff8996, 0xeb7bafb0, 0xc521ff26, 0xf3dbb791, 0xaf6862a8,
-    0x865b38fd, 0xb74451c9, 0x56097f74, 0x55f957fa, 0x57805420, 0xa1961410};
-
-// representing the value of the highes trit in the feasible domain, i.e 3^242
-static const uint32_t TRIT_243[12] = {
-    0x4b9d12c9, 0x3e00ecd3, 0x2908a09f, 0x75bc01b2, 0x184890dc, 0xa12f3aae,
-    0xf3498e04, 0x91775c6c, 0x53ed0116, 0x540d500b, 0x50ff57bf, 0xbcd3d7df};
-
-#ifdef USE_UNSAFE_INCREMENT_TAG
-// representing the value of the 82nd trit, i.e. 3^81
-static const uint32_t TRIT_82[12] = {0xd56d7cc3, 0xb6bf0c69, 0xa149e834,
-                                     0x4d98d5ce, 0x1};
-#endif // USE_UNSAFE_INCREMENT_TAG
-
 static const trit_t trits_mapping[27][3] = {
     {-1, -1, -1}, {0, -1, -1}, {1, -1, -1}, {-1, 0, -1}, {0, 0, -1}, {1, 0, -1},
     {-1, 1, -1},  {0, 1, -1},  {1, 1, -1},  {-1, -1, 0}, {0, -1, 0}, {1, -1, 0},
@@ -36,9 +13,6 @@ static const trit_t trits_mapping[27][3] = {
     {-1, -1, 1},  {0, -1, 1},  {1, -1, 1},  {-1, 0, 1},  {0, 0, 1},  {1, 0, 1},
     {-1, 1, 1},   {0, 1, 1},   {1, 1, 1}};
 
-// available tryte chars in the correct order
-static const char tryte_to_char_mapping[] = "NOPQRSTUVWXYZ9ABCDEFGHIJKLM";
-
 /* --------------------- trits > trytes and back */
 // used for bytes to chars and back
 int trytes_to_trits(const tryte_t trytes_in[], trit_t trits_out[],
@@ -74,394 +48,510 @@ int trits_to_trytes(const trit_t trits_in[], tryte_t trytes_out[],
 int chars_to_trytes(const char chars_in[], tryte_t trytes_out[],
                     unsigned int len)
 {
-    for (unsigned int i = 0; i < len; i++) {
-        if (chars_in[i] == '9') {
-            trytes_out[i] = 0;
-        }
-        else if ((int8_t)chars_in[i] >= 'N') {
-            trytes_out[i] = (int8_t)(chars_in[i]) - 64 - 27;
-        }
-        else {
-            trytes_out[i] = (int8_t)(chars_in[i]) - 64;
-        }
-    }
+    dispatch->chars_to_trytes(chars_in, trytes_out, len);
     return 0;
 }
 
 int trytes_to_chars(const tryte_t trytes_in[], char chars_out[],
                     unsigned int len)
 {
-    for (unsigned int i = 0; i < len; i++) {
-        chars_out[i] = tryte_to_char_mapping[trytes_in[i] + 13];
-    }
-
+    dispatch->trytes_to_chars(trytes_in, chars_out, len);
     return 0;
 }
 /* --------------------- END trytes > chars */
 
 void chars_to_trits(const char *chars, trit_t *trits, unsigned int chars_len)
 {
-    tryte_t trytes[chars_len];
-    chars_to_trytes(chars, trytes, chars_len);
-    trytes_to_trits(trytes, trits, chars_len);
+    TERNARY_STREAM ctx;
+    ternary_stream_initialize(&ctx, TERNARY_CHARS, TERNARY_TRITS);
+    ternary_stream_write(&ctx, chars, chars_len, trits);
 }
 
 void trits_to_chars(const trit_t *trits, char *chars, unsigned int trit_len)
 {
-    tryte_t trytes[trit_len / 3];
-    trits_to_trytes(trits, trytes, trit_len);
-    trytes_to_chars(trytes, chars, trit_len / 3);
+    TERNARY_STREAM ctx;
+    ternary_stream_initialize(&ctx, TERNARY_TRITS, TERNARY_CHARS);
+    ternary_stream_write(&ctx, trits, trit_len, chars);
 }
 
-/** @brief Returns true, if the long little-endian integer represents a negative
- *         number in two's complement.
- */
-static inline bool bigint_is_negative(const uint32_t *bigint)
-{
-    // whether the most significant bit of the most significant byte is set
-    return (bigint[12 - 1] >> (sizeof(bigint[0]) * 8 - 1) != 0);
-}
+/* --------------------- streaming conversion */
+// number of trytes converted at once, bounding the stack usage
+#define STREAM_BLOCK_TRYTES 81
 
-static int bigint_cmp(const uint32_t *a, const uint32_t *b)
+/** @brief Writes trytes in the given encoding and returns the number of
+ *         elements written. */
+static unsigned int stream_emit_trytes(TERNARY_FORMAT output,
+                                       const tryte_t *trytes, unsigned int len,
+                                       unsigned char *out)
 {
-    for (unsigned int i = 12; i-- > 0;) {
-        if (a[i] < b[i]) {
-            return -1;
-        }
-        if (a[i] > b[i]) {
-            return 1;
-        }
+    switch (output) {
+    case TERNARY_TRITS:
+        trytes_to_trits(trytes, (trit_t *)out, len);
+        return 3 * len;
+    case TERNARY_TRYTES:
+        os_memcpy(out, trytes, len);
+        return len;
+    default:
+        trytes_to_chars(trytes, (char *)out, len);
+        return len;
     }
-    return 0;
 }
 
-static inline bool addcarry_u32(uint32_t *r, uint32_t a, uint32_t b, bool c_in)
+void ternary_stream_initialize(TERNARY_STREAM *ctx, TERNARY_FORMAT input,
+                               TERNARY_FORMAT output)
 {
-    const uint32_t sum = a + b + (c_in ? 1 : 0);
-    const bool carry = (sum < a) || (c_in && (sum <= a));
-
-    *r = sum;
-    return carry;
+    ctx->input = input;
+    ctx->output = output;
+    ctx->num_pending = 0;
 }
 
-static bool bigint_add(uint32_t *r, const uint32_t *a, const uint32_t *b)
+unsigned int ternary_stream_output_len(const TERNARY_STREAM *ctx,
+                                       unsigned int len)
 {
-    bool carry = false;
-    for (unsigned int i = 0; i < 12; i++) {
-        carry = addcarry_u32(&r[i], a[i], b[i], carry);
+    if (ctx->input == TERNARY_TRITS) {
+        if (ctx->output == TERNARY_TRITS) {
+            return len;
+        }
+        return (ctx->num_pending + len) / 3;
     }
-
-    return carry;
+    return ctx->output == TERNARY_TRITS ? 3 * len : len;
 }
 
-static bool bigint_sub(uint32_t *r, const uint32_t *a, const uint32_t *b)
+/** @brief Converts trit input, keeping the trits of an incomplete tryte. */
+static unsigned int stream_write_trits(TERNARY_STREAM *ctx,
+                                       const trit_t *trits, unsigned int len,
+                                       unsigned char *out)
 {
-    bool carry = true;
-    for (unsigned int i = 0; i < 12; i++) {
-        carry = addcarry_u32(&r[i], a[i], ~b[i], carry);
+    tryte_t trytes[STREAM_BLOCK_TRYTES];
+    unsigned int written = 0;
+
+    // complete the pending tryte first
+    if (ctx->num_pending > 0) {
+        while (ctx->num_pending < 3 && len > 0) {
+            ctx->pending[ctx->num_pending++] = *trits++;
+            len--;
+        }
+        if (ctx->num_pending < 3) {
+            return 0;
+        }
+        trits_to_trytes(ctx->pending, trytes, 3);
+        written += stream_emit_trytes(ctx->output, trytes, 1, out);
+        ctx->num_pending = 0;
+    }
+
+    while (len >= 3) {
+        const unsigned int n = MIN(len / 3, STREAM_BLOCK_TRYTES);
+        trits_to_trytes(trits, trytes, 3 * n);
+        written += stream_emit_trytes(ctx->output, trytes, n, out + written);
+        trits += 3 * n;
+        len -= 3 * n;
     }
 
-    return carry;
+    os_memcpy(ctx->pending, trits, len);
+    ctx->num_pending = len;
+
+    return written;
 }
 
-/** @brief adds a single 32-bit integer to a long little-endian integer.
- *  @return index of the most significant word which changed during the addition
- */
-unsigned int bigint_add_u32_mem(uint32_t *a, uint32_t summand)
+unsigned int ternary_stream_write(TERNARY_STREAM *ctx, const void *in,
+                                  unsigned int len, void *out)
 {
-    bool carry = addcarry_u32(&a[0], a[0], summand, false);
-    if (carry == false) {
-        return 0;
+    const unsigned char *src = in;
+    unsigned char *dst = out;
+
+    if (ctx->input == TERNARY_TRITS) {
+        if (ctx->output == TERNARY_TRITS) {
+            os_memcpy(dst, src, len);
+            return len;
+        }
+        return stream_write_trits(ctx, (const trit_t *)src, len, dst);
     }
 
-    for (unsigned int i = 1; i < 12; i++) {
-        carry = addcarry_u32(&a[i], a[i], 0, true);
-        if (carry == false) {
-            return i;
+    // tryte and char input is always tryte aligned
+    tryte_t block[STREAM_BLOCK_TRYTES];
+    unsigned int written = 0;
+
+    for (unsigned int i = 0; i < len; i += STREAM_BLOCK_TRYTES) {
+        const unsigned int n = MIN(len - i, STREAM_BLOCK_TRYTES);
+        const tryte_t *trytes = (const tryte_t *)src + i;
+
+        if (ctx->input == TERNARY_CHARS) {
+            chars_to_trytes((const char *)src + i, block, n);
+            trytes = block;
         }
+        written += stream_emit_trytes(ctx->output, trytes, n, dst + written);
     }
 
-    // overflow
-    return 12;
+    return written;
 }
 
-/** @brief multiplies a single 8-bit integer with a long little-endian integer.
- *  @param ms_index the index of the most significant non-zero word of the
- *                  input integer. Words after this are not considered.
- *  @return the carry (one word) of the multiplication up to the byte which has
-            the index specified in msb_index.
- */
-static uint32_t bigint_mult_byte_mem(uint32_t *a, uint8_t factor,
-                                     unsigned int ms_index)
+unsigned int ternary_stream_finalize(TERNARY_STREAM *ctx, void *out)
 {
-    uint32_t carry = 0;
-
-    for (unsigned int i = 0; i <= ms_index; i++) {
-        const uint64_t v = (uint64_t)factor * a[i] + carry;
+    unsigned int written = 0;
 
-        carry = v >> 32;
-        a[i] = v & 0xFFFFFFFF;
+    if (ctx->num_pending > 0) {
+        tryte_t tryte;
+        os_memset(ctx->pending + ctx->num_pending, 0, 3 - ctx->num_pending);
+        trits_to_trytes(ctx->pending, &tryte, 3);
+        written = stream_emit_trytes(ctx->output, &tryte, 1, out);
     }
+    ctx->num_pending = 0;
 
-    return carry;
+    return written;
 }
+/* --------------------- END streaming conversion */
 
-/** @brief devides a long big-endian integer by a single 8-bit integer.
- *  @return remainder of the integer division.
- */
-static uint32_t bigint_div_byte_mem(uint32_t *a, uint8_t divisor)
+/* --------------------- trits > packed bytes and back */
+/** @brief Returns the byte encoding up to 5 trits, missing trits are 0. */
+static inline unsigned char trits_to_packed_byte(const trit_t *trits,
+                                                 unsigned int num_trits)
 {
-    uint32_t remainder = 0;
+    trit_t t[TRITS_PER_PACKED_BYTE] = {0};
+    os_memcpy(t, trits, num_trits);
+
+    // the lower three trits as index into trits_mapping, then the upper two
+    const unsigned int lower = t[0] + t[1] * 3 + t[2] * 9 + 13;
+    const unsigned int upper = t[3] + t[4] * 3 + 4;
 
-    for (unsigned int i = 12; i-- > 0;) {
-        const uint64_t v = UINT64_C(0x100000000) * remainder + a[i];
+    return lower + 27 * upper;
+}
 
-        remainder = v % divisor;
-        a[i] = (v / divisor) & 0xFFFFFFFF;
+int trits_to_packed(const trit_t *trits, unsigned char *packed,
+                    unsigned int num_trits)
+{
+    unsigned int i = 0;
+    for (; i + TRITS_PER_PACKED_BYTE <= num_trits;
+         i += TRITS_PER_PACKED_BYTE) {
+        *packed++ = trits_to_packed_byte(trits + i, TRITS_PER_PACKED_BYTE);
+    }
+    if (i < num_trits) {
+        *packed = trits_to_packed_byte(trits + i, num_trits - i);
     }
 
-    return remainder;
+    return 0;
 }
 
-/** @brief Changes number to the corresponding representation of the number
- *         with the 242th trit set to 0.
- * @return true, if the number was changed, false otherwise.
- */
-static bool bigint_set_last_trit_zero(uint32_t *bigint)
+int packed_to_trits(const unsigned char *packed, trit_t *trits,
+                    unsigned int num_trits)
 {
-    if (bigint_is_negative(bigint)) {
-        if (bigint_cmp(bigint, NEG_HALF_3) < 0) {
-            bigint_add(bigint, bigint, TRIT_243);
-            return true;
-        }
-    }
-    else {
-        if (bigint_cmp(bigint, HALF_3) > 0) {
-            bigint_sub(bigint, bigint, TRIT_243);
-            return true;
+    for (unsigned int i = 0; i < num_trits; i += TRITS_PER_PACKED_BYTE) {
+        const unsigned char byte = *packed++;
+        if (byte >= 243) {
+            return -1;
         }
+
+        trit_t t[TRITS_PER_PACKED_BYTE];
+        os_memcpy(t, trits_mapping[byte % 27], 3);
+        os_memcpy(t + 3, trits_mapping[byte / 27], 2);
+
+        os_memcpy(trits + i, t, MIN(num_trits - i, TRITS_PER_PACKED_BYTE));
     }
-    return false;
+
+    return 0;
 }
 
-/* --------------------- trits > bigint and back */
-static void trits_to_bigint(const trit_t *trits, uint32_t *bigint)
+// number of trytes whose trits fill exactly three packed bytes
+#define PACKED_TRYTES_BLOCK 5
+
+int trytes_to_packed(const tryte_t *trytes, unsigned char *packed,
+                     unsigned int num_trytes)
 {
-    unsigned int ms_index = 0; // initialy there is no most significant word >0
-    os_memset(bigint, 0, 12 * sizeof(bigint[0]));
+    for (unsigned int i = 0; i < num_trytes; i += PACKED_TRYTES_BLOCK) {
+        const unsigned int n = MIN(num_trytes - i, PACKED_TRYTES_BLOCK);
 
-    // ignore the 243th trit, as it cannot be fully represented in 48 bytes
-    for (unsigned int i = 242; i-- > 0;) {
-        // convert to non-balanced ternary
-        const uint8_t trit = trits[i] + 1;
+        trit_t trits[PACKED_TRYTES_BLOCK * 3];
+        trytes_to_trits(trytes + i, trits, n);
+        trits_to_packed(trits, packed, n * 3);
+        packed += NUM_PACKED_BYTES(PACKED_TRYTES_BLOCK * 3);
+    }
 
-        const uint32_t carry = bigint_mult_byte_mem(bigint, BASE, ms_index);
-        if (carry > 0) {
-            // if there is carry we need to use the next higher byte
-            bigint[++ms_index] = carry;
-        }
+    return 0;
+}
 
-        if (trit == 0) {
-            // nothing to add
-            continue;
-        }
+int packed_to_trytes(const unsigned char *packed, tryte_t *trytes,
+                     unsigned int num_trytes)
+{
+    for (unsigned int i = 0; i < num_trytes; i += PACKED_TRYTES_BLOCK) {
+        const unsigned int n = MIN(num_trytes - i, PACKED_TRYTES_BLOCK);
 
-        const unsigned int last_changed_index =
-            bigint_add_u32_mem(bigint, trit);
-        if (last_changed_index > ms_index) {
-            ms_index = last_changed_index;
+        trit_t trits[PACKED_TRYTES_BLOCK * 3];
+        if (packed_to_trits(packed, trits, n * 3) != 0) {
+            return -1;
         }
+        trits_to_trytes(trits, trytes + i, n * 3);
+        packed += NUM_PACKED_BYTES(PACKED_TRYTES_BLOCK * 3);
     }
 
-    // convert to balanced ternary using two's complement
-    if (bigint_cmp(bigint, HALF_3) >= 0) {
-        bigint_sub(bigint, bigint, HALF_3);
-    }
-    else {
-        // equivalent to bytes := ~(HALF_3 - bytes) + 1
-        bigint_add(bigint, NEG_HALF_3, bigint);
-    }
+    return 0;
 }
+/* --------------------- END trits > packed bytes */
 
-static void bigint_to_trits_mem(uint32_t *bigint, trit_t *trits)
+/** @brief Returns the magnitude of the signed integer, also for INT64_MIN. */
+static inline uint64_t int64_magnitude(int64_t value)
 {
-    // the two's complement represention is only correct, if the number fits
-    // into 48 bytes, i.e. has the 243th trit set to 0
-    bigint_set_last_trit_zero(bigint);
+    return value < 0 ? -(uint64_t)value : (uint64_t)value;
+}
 
-    // convert to the (positive) number representing non-balanced ternary
-    if (bigint_is_negative(bigint)) {
-        bigint_sub(bigint, bigint, NEG_HALF_3);
-    }
-    else {
-        bigint_add(bigint, bigint, HALF_3);
+/** @brief Removes the least significant balanced tryte from the magnitude.
+ *  @return the balanced tryte
+ */
+static inline int tryte_divide(uint64_t *magnitude)
+{
+    int rem = *magnitude % 27;
+    *magnitude /= 27;
+    if (rem > MAX_TRYTE_VALUE) {
+        rem -= 27;
+        *magnitude += 1;
     }
 
-    // ignore the 243th trit, as it cannot be fully represented in 48 bytes
-    for (unsigned int i = 0; i < 242; i++) {
-        const uint32_t rem = bigint_div_byte_mem(bigint, BASE);
-        trits[i] = rem - 1; // convert back to balanced
-    }
-    // set the last trit to zero for consistency
-    trits[242] = 0;
+    return rem;
 }
 
 bool int64_to_trits(int64_t value, trit_t *trits, unsigned int num_trits)
 {
     const bool is_negative = value < 0;
-    if (is_negative) {
-        value = -value;
-    }
+    uint64_t magnitude = int64_magnitude(value);
 
     os_memset(trits, 0, num_trits);
 
-    for (unsigned int i = 0; i < num_trits; i++) {
-        if (value == 0) {
-            return false;
-        }
-
-        int rem = value % BASE;
-        value = value / BASE;
+    // three trits at once using the tryte mapping
+    unsigned int i = 0;
+    for (; magnitude != 0 && i + 3 <= num_trits; i += 3) {
+        const int rem = tryte_divide(&magnitude);
+        os_memcpy(trits + i, trits_mapping[rem + 13], 3);
+    }
+    for (; magnitude != 0 && i < num_trits; i++) {
+        int rem = magnitude % BASE;
+        magnitude /= BASE;
         if (rem > 1) {
             rem = -1;
-            value += 1;
+            magnitude += 1;
         }
+        trits[i] = rem;
+    }
 
-        trits[i] = is_negative ? -rem : rem;
+    if (is_negative) {
+        for (unsigned int j = 0; j < i; j++) {
+            trits[j] = -trits[j];
+        }
     }
 
-    return value != 0;
+    return magnitude != 0;
 }
-/* --------------------- END trits > bigint */
 
-/** @brief Converts bigint consisting of 12 words into an array of bytes.
- *  It is represented using 48bytes in big-endiean, by reversing the order of
- *  the words. The endianness of the host machine is taken into account.
- */
-static void bigint_to_bytes(const uint32_t *bigint, unsigned char *bytes)
+bool int64_to_trytes(int64_t value, tryte_t *trytes, unsigned int num_trytes)
 {
-    // reverse word order
-    for (unsigned int i = 12; i-- > 0; bytes += 4) {
-        const uint32_t num = bigint[i];
+    const bool is_negative = value < 0;
+    uint64_t magnitude = int64_magnitude(value);
+
+    os_memset(trytes, 0, num_trytes);
+
+    for (unsigned int i = 0; magnitude != 0 && i < num_trytes; i++) {
+        const int rem = tryte_divide(&magnitude);
+        trytes[i] = is_negative ? -rem : rem;
+    }
 
-        bytes[0] = (num >> 24) & 0xFF;
-        bytes[1] = (num >> 16) & 0xFF;
-        bytes[2] = (num >> 8) & 0xFF;
-        bytes[3] = (num >> 0) & 0xFF;
+    return magnitude != 0;
+}
+
+/** @brief Appends the balanced digit to the positive magnitude.
+ *  @return true, if the magnitude became too large for any 64-bit integer
+ */
+static inline bool magnitude_append(uint64_t *magnitude, unsigned int radix,
+                                    int digit)
+{
+    // the digits are at least -13, and the most significant one is positive
+    if (*magnitude > (UINT64_MAX - 13) / radix) {
+        return true;
     }
+
+    *magnitude = *magnitude * radix + digit;
+    return false;
 }
 
-/** @brief Converts an array of 48 bytes into a bigint consisting of 12 words.
- *  The bigint is represented using 48bytes in big-endiean. The endianness of
- * the host machine is taken into account.
+/** @brief Sets the value to the signed magnitude.
+ *  @return true, if the magnitude cannot be represented as a 64-bit integer
  */
-static void bytes_to_bigint(const unsigned char *bytes, uint32_t *bigint)
+static inline bool magnitude_to_int64(uint64_t magnitude, bool is_negative,
+                                      int64_t *value)
 {
-    // reverse word order
-    for (unsigned int i = 12; i-- > 0; bytes += 4) {
-        bigint[i] = (uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 |
-                    (uint32_t)bytes[2] << 8 | (uint32_t)bytes[3] << 0;
+    if (magnitude > (uint64_t)INT64_MAX + (is_negative ? 1 : 0)) {
+        return true;
     }
+
+    // negating the magnitude minus one also works for INT64_MIN
+    *value = is_negative && magnitude > 0 ? -(int64_t)(magnitude - 1) - 1
+                                          : (int64_t)magnitude;
+    return false;
 }
 
+bool trits_to_int64(const trit_t *trits, unsigned int num_trits,
+                    int64_t *value)
+{
+    // the sign of the number is the sign of its most significant non-zero
+    // trit, flip all trits of negative numbers to evaluate the magnitude
+    unsigned int i = num_trits;
+    while (i > 0 && trits[i - 1] == 0) {
+        i--;
+    }
+    const int sign = (i > 0 && trits[i - 1] < 0) ? -1 : 1;
+
+    uint64_t magnitude = 0;
+    // the most significant trits not forming a whole tryte one by one
+    for (; i % 3 != 0; i--) {
+        if (magnitude_append(&magnitude, BASE, sign * trits[i - 1])) {
+            return true;
+        }
+    }
+    // then three trits at once
+    for (; i > 0; i -= 3) {
+        const int tryte = trits[i - 3] + trits[i - 2] * 3 + trits[i - 1] * 9;
+        if (magnitude_append(&magnitude, 27, sign * tryte)) {
+            return true;
+        }
+    }
+
+    return magnitude_to_int64(magnitude, sign < 0, value);
+}
+
+bool trytes_to_int64(const tryte_t *trytes, unsigned int num_trytes,
+                     int64_t *value)
+{
+    // the sign of the most significant non-zero tryte is the sign of the number
+    unsigned int i = num_trytes;
+    while (i > 0 && trytes[i - 1] == 0) {
+        i--;
+    }
+    const int sign = (i > 0 && trytes[i - 1] < 0) ? -1 : 1;
+
+    uint64_t magnitude = 0;
+    for (; i > 0; i--) {
+        if (magnitude_append(&magnitude, 27, sign * trytes[i - 1])) {
+            return true;
+        }
+    }
+
+    return magnitude_to_int64(magnitude, sign < 0, value);
+}
+
+/* --------------------- bigint conversions, see conversion_kernels.c */
+
 void trits_to_bytes(const trit_t *trits, unsigned char *bytes)
 {
-    uint32_t bigint[12];
-    trits_to_bigint(trits, bigint);
-    bigint_to_bytes(bigint, bytes);
+    dispatch->trits_to_bytes(trits, bytes);
+}
+
+void trits_to_bytes_n(const trit_t *trits, unsigned char *bytes,
+                      unsigned int num_chunks)
+{
+    dispatch->trits_to_bytes_n(trits, bytes, num_chunks);
 }
 
 void trytes_to_bytes(const tryte_t *trytes, unsigned char *bytes)
 {
-    trit_t trits[243];
-    trytes_to_trits(trytes, trits, 81);
-    trits_to_bytes(trits, bytes);
+    dispatch->trytes_to_bytes(trytes, bytes);
 }
 
 void chars_to_bytes(const char *chars, unsigned char *bytes,
                     unsigned int chars_len)
 {
     for (unsigned int i = 0; i < chars_len / 81; i++) {
-        trit_t trits[243];
-        chars_to_trits(chars + i * 81, trits, 81);
-        // bigint can only handle 242 trits
-        trits[242] = 0;
-
-        trits_to_bytes(trits, bytes + i * 48);
+        tryte_t trytes[81];
+        chars_to_trytes(chars + i * 81, trytes, 81);
+        trytes_to_bytes(trytes, bytes + i * 48);
     }
 }
 
 static inline void bytes_to_trits(const unsigned char *bytes, trit_t *trits)
 {
-    uint32_t bigint[12];
-    bytes_to_bigint(bytes, bigint);
-    bigint_to_trits_mem(bigint, trits);
+    dispatch->bytes_to_trits(bytes, trits);
 }
 
 void bytes_to_trytes(const unsigned char *bytes, tryte_t *trytes)
 {
-    trit_t trits[243];
-    bytes_to_trits(bytes, trits);
-    trits_to_trytes(trits, trytes, 243);
+    dispatch->bytes_to_trytes(bytes, trytes);
+}
+
+void bytes_to_trytes_n(const unsigned char *bytes, tryte_t *trytes,
+                       unsigned int num_chunks)
+{
+    dispatch->bytes_to_trytes_n(bytes, trytes, num_chunks);
 }
 
+// number of chunks bytes_to_chars converts at once
+#define CHARS_BATCH_CHUNKS 4
+
 void bytes_to_chars(const unsigned char *bytes, char *chars,
                     unsigned int bytes_len)
 {
-    for (unsigned int i = 0; i < bytes_len / 48; i++) {
-        tryte_t trytes[81];
-        bytes_to_trytes(bytes + i * 48, trytes);
-        trytes_to_chars(trytes, chars + i * 81, 81);
+    const unsigned int num_chunks = bytes_len / 48;
+
+    for (unsigned int i = 0; i < num_chunks; i += CHARS_BATCH_CHUNKS) {
+        const unsigned int n = MIN(num_chunks - i, CHARS_BATCH_CHUNKS);
+
+        tryte_t trytes[CHARS_BATCH_CHUNKS * 81];
+        bytes_to_trytes_n(bytes + i * 48, trytes, n);
+        trytes_to_chars(trytes, chars + i * 81, n * 81);
     }
 }
 
+// big-endian bytes of the middle of the domain described by 242 trits, i.e.
+// \sum_{k=0}^{241} 3^k, and of its two's complement
+static const unsigned char HALF_3_BYTES[48] = {
+    0x5e, 0x69, 0xeb, 0xef, 0xa8, 0x7f, 0xab, 0xdf, 0xaa, 0x06, 0xa8, 0x05,
+    0xa9, 0xf6, 0x80, 0x8b, 0x48, 0xbb, 0xae, 0x36, 0x79, 0xa4, 0xc7, 0x02,
+    0x50, 0x97, 0x9d, 0x57, 0x0c, 0x24, 0x48, 0x6e, 0x3a, 0xde, 0x00, 0xd9,
+    0x14, 0x84, 0x50, 0x4f, 0x9f, 0x00, 0x76, 0x69, 0xa5, 0xce, 0x89, 0x64};
+static const unsigned char NEG_HALF_3_BYTES[48] = {
+    0xa1, 0x96, 0x14, 0x10, 0x57, 0x80, 0x54, 0x20, 0x55, 0xf9, 0x57, 0xfa,
+    0x56, 0x09, 0x7f, 0x74, 0xb7, 0x44, 0x51, 0xc9, 0x86, 0x5b, 0x38, 0xfd,
+    0xaf, 0x68, 0x62, 0xa8, 0xf3, 0xdb, 0xb7, 0x91, 0xc5, 0x21, 0xff, 0x26,
+    0xeb, 0x7b, 0xaf, 0xb0, 0x60, 0xff, 0x89, 0x96, 0x5a, 0x31, 0x76, 0x9c};
+
 void bytes_set_last_trit_zero(unsigned char *bytes)
 {
-    uint32_t bigint[12];
-    bytes_to_bigint(bytes, bigint);
-    if (bigint_set_last_trit_zero(bigint)) {
-        bigint_to_bytes(bigint, bytes);
+    // the 243th trit is only set, if the number lies outside of the interval
+    // [-HALF_3, HALF_3], which can mostly be ruled out by the most significant
+    // word alone, i.e. when it is smaller than the one of HALF_3 or larger
+    // than the one of the two's complement NEG_HALF_3
+    const uint32_t msw = (uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 |
+                         (uint32_t)bytes[2] << 8 | (uint32_t)bytes[3] << 0;
+    if (msw < 0x5e69ebef || msw > 0xa1961410) {
+        return;
     }
-}
-
-static void increment_trit_aera(trit_t *trits, unsigned int start_trit,
-                                unsigned int num_trits)
-{
-    trit_t *trit = trits + start_trit;
 
-    for (unsigned int i = 0; i < num_trits; i++, trit++) {
-        if (*trit < MAX_TRIT_VALUE) {
-            *trit += 1;
-            break;
+    // otherwise compare all bytes, as big-endian they compare like the numbers
+    if (bytes[0] & 0x80) {
+        if (memcmp(bytes, NEG_HALF_3_BYTES, 48) >= 0) {
+            return;
         }
-        *trit = MIN_TRIT_VALUE;
     }
+    else if (memcmp(bytes, HALF_3_BYTES, 48) <= 0) {
+        return;
+    }
+
+    // only the rare numbers which actually need to be changed use the bigint
+    dispatch->bytes_set_last_trit_zero(bytes);
 }
 
-// TODO: there are faster and more efficient algos for this, but is it worth it?
 void bytes_increment_trit_area_81(unsigned char *bytes)
 {
-#ifdef USE_UNSAFE_INCREMENT_TAG
-    uint32_t bigint[12];
-    bytes_to_bigint(bytes, bigint);
-    bigint_add(bigint, bigint, TRIT_82);
-    bigint_to_bytes(bigint, bytes);
-#else
-    trit_t trits[243];
-    bytes_to_trits(bytes, trits);
-    increment_trit_aera(trits, 81, 81);
-    trits_to_bytes(trits, bytes);
-#endif // USE_UNSAFE_INCREMENT_TAG
+    dispatch->bytes_increment_trit_area_81(bytes);
 }
 
 void bytes_add_u32_mem(unsigned char *bytes, uint32_t summand)
 {
-    if (summand > 0) {
-        uint32_t bigint[12];
+    dispatch->bytes_add_u32_mem(bytes, summand);
+}
 
-        bytes_to_bigint(bytes, bigint);
-        bigint_add_u32_mem(bigint, summand);
-        bigint_set_last_trit_zero(bigint);
-        bigint_to_bytes(bigint, bytes);
+void bytes_increment(unsigned char *bytes)
+{
+    // the two's complement addition only carries into more significant bytes
+    for (unsigned int i = 48; i-- > 0;) {
+        if (++bytes[i] != 0) {
+            break;
+        }
     }
+
+    bytes_set_last_trit_zero(bytes);
 }
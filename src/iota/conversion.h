@@ -24,6 +24,109 @@ void chars_to_trits(const char *chars, trit_t *trits, unsigned int chars_len);
  */
 void trits_to_chars(const trit_t *trits, char *chars, unsigned int trit_len);
 
+/** @brief Encoding of the ternary data read or written by a TERNARY_STREAM.
+ *  Each element of any of the encodings is exactly one byte.
+ */
+typedef enum TERNARY_FORMAT {
+        TERNARY_TRITS,
+        TERNARY_TRYTES,
+        TERNARY_CHARS
+} TERNARY_FORMAT;
+
+/** @brief Context of a streaming conversion between ternary encodings.
+ *  The input can be written in pieces of arbitrary length, all complete
+ *  trytes are converted immediately. Only the trits of an incomplete tryte are
+ *  kept in the context, so its size does not depend on the input length.
+ */
+typedef struct TERNARY_STREAM {
+        TERNARY_FORMAT input;
+        TERNARY_FORMAT output;
+
+        // trits not yet forming a complete tryte, only used for trit input
+        trit_t pending[3];
+        unsigned int num_pending;
+} TERNARY_STREAM;
+
+/** @brief Initializes the context for a streaming conversion.
+ *  @param ctx the stream context used
+ *  @param input encoding of the written data
+ *  @param output encoding of the converted data
+ */
+void ternary_stream_initialize(TERNARY_STREAM *ctx, TERNARY_FORMAT input,
+                               TERNARY_FORMAT output);
+
+/** @brief Returns the maximum number of elements written by
+ *         ternary_stream_write() for an input of the given length.
+ *  @param ctx the stream context used
+ *  @param len number of input elements
+ */
+unsigned int ternary_stream_output_len(const TERNARY_STREAM *ctx,
+                                       unsigned int len);
+
+/** @brief Converts the next piece of the input.
+ *  @param ctx the stream context used
+ *  @param in input array in the input encoding
+ *  @param len number of input elements
+ *  @param out target array of at least ternary_stream_output_len() elements
+ *  @return number of elements written to out
+ */
+unsigned int ternary_stream_write(TERNARY_STREAM *ctx, const void *in,
+                                  unsigned int len, void *out);
+
+/** @brief Finishes the conversion, so that the context can be reused.
+ *  An incomplete last tryte is padded with zero trits.
+ *  @param ctx the stream context used
+ *  @param out target array of at least one element
+ *  @return number of elements written to out, i.e. 0 or 1
+ */
+unsigned int ternary_stream_finalize(TERNARY_STREAM *ctx, void *out);
+
+// number of trits stored in one byte of the packed encoding, as 3^5 <= 256
+#define TRITS_PER_PACKED_BYTE 5
+
+// number of bytes of the packed encoding of the given number of trits
+#define NUM_PACKED_BYTES(num_trits)                                            \
+    (((num_trits) + TRITS_PER_PACKED_BYTE - 1) / TRITS_PER_PACKED_BYTE)
+
+/** @brief Packs balanced trits into bytes of 5 trits each.
+ *  Each byte is the non-balanced value of its trits, the first trit being the
+ *  least significant one. A partial last byte is padded with zero trits.
+ *  @param trits input trit array
+ *  @param packed target array of NUM_PACKED_BYTES(num_trits) bytes
+ *  @param num_trits number of trits to pack
+ *  @return 0
+ */
+int trits_to_packed(const trit_t *trits, unsigned char *packed,
+                    unsigned int num_trits);
+
+/** @brief Unpacks bytes of 5 trits each into balanced trits.
+ *  @param packed input array of NUM_PACKED_BYTES(num_trits) bytes
+ *  @param trits target trit array
+ *  @param num_trits number of trits to unpack
+ *  @return 0, or -1 if a byte is not a valid packed value, i.e. larger than 242
+ */
+int packed_to_trits(const unsigned char *packed, trit_t *trits,
+                    unsigned int num_trits);
+
+/** @brief Packs trytes into bytes of 5 trits each.
+ *  The result is identical to packing the trits of the trytes.
+ *  @param trytes input tryte array
+ *  @param packed target array of NUM_PACKED_BYTES(3 * num_trytes) bytes
+ *  @param num_trytes number of trytes to pack
+ *  @return 0
+ */
+int trytes_to_packed(const tryte_t *trytes, unsigned char *packed,
+                     unsigned int num_trytes);
+
+/** @brief Unpacks bytes of 5 trits each into trytes.
+ *  @param packed input array of NUM_PACKED_BYTES(3 * num_trytes) bytes
+ *  @param trytes target tryte array
+ *  @param num_trytes number of trytes to unpack
+ *  @return 0, or -1 if a byte is not a valid packed value, i.e. larger than 242
+ */
+int packed_to_trytes(const unsigned char *packed, tryte_t *trytes,
+                     unsigned int num_trytes);
+
 /** @brief Converts a single signed integer into its ternary representation.
  *  @param value signed integer to convert
  *  @param trits target trit array
@@ -33,6 +136,37 @@ void trits_to_chars(const trit_t *trits, char *chars, unsigned int trit_len);
  */
 bool int64_to_trits(int64_t value, trit_t *trits, unsigned int num_trits);
 
+/** @brief Converts a single signed integer into its tryte representation.
+ *  @param value signed integer to convert
+ *  @param trytes target tryte array
+ *  @param num_trytes number of trytes to convert
+ *  @return true, if an overflow occured and the given integer could not be
+            completely represented with this number of trytes, false otherwise.
+ */
+bool int64_to_trytes(int64_t value, tryte_t *trytes, unsigned int num_trytes);
+
+/** @brief Converts a balanced ternary number into a single signed integer.
+ *  @param trits input trit array, the first trit being the least significant
+ *  @param num_trits number of trits to convert
+ *  @param value target integer, unchanged in case of an overflow
+ *  @return true, if an overflow occured and the number could not be
+            represented as a 64-bit integer, false otherwise.
+ */
+bool trits_to_int64(const trit_t *trits, unsigned int num_trits,
+                    int64_t *value);
+
+/** @brief Converts a balanced ternary number in tryte representation into a
+ *         single signed integer.
+ *  @param trytes input tryte array, the first tryte being the least
+ *                significant
+ *  @param num_trytes number of trytes to convert
+ *  @param value target integer, unchanged in case of an overflow
+ *  @return true, if an overflow occured and the number could not be
+            represented as a 64-bit integer, false otherwise.
+ */
+bool trytes_to_int64(const tryte_t *trytes, unsigned int num_trytes,
+                     int64_t *value);
+
 /** @brief Converts a balanced ternary number into a big-endian binary integer.
  *  The input must consist of exactly one 243-trit chunk and is converted into
  *  one big-endian 48-byte integer.
@@ -41,6 +175,17 @@ bool int64_to_trits(int64_t value, trit_t *trits, unsigned int num_trits);
  */
 void trits_to_bytes(const trit_t *trits, unsigned char *bytes);
 
+/** @brief Converts several balanced ternary numbers into big-endian binary
+ *         integers.
+ *  This is equivalent to calling trits_to_bytes for each 243-trit chunk, but
+ *  converts several chunks at once.
+ *  @param trits trit array consisting of num_chunks * 243 trits
+ *  @param bytes target byte array of num_chunks * 48 bytes
+ *  @param num_chunks number of chunks to convert
+ */
+void trits_to_bytes_n(const trit_t *trits, unsigned char *bytes,
+                      unsigned int num_chunks);
+
 /** @brief Converts a balanced ternary number in tryte (3-trit) representation
  *         into a big-endian binary integer.
  *  The input must consist of exactly one 81-tryte (243-trit) chunk and is
@@ -59,6 +204,17 @@ void trytes_to_bytes(const tryte_t *trytes, unsigned char *bytes);
  */
 void bytes_to_trytes(const unsigned char *bytes, tryte_t *trytes);
 
+/** @brief Converts several big-endian binary integers into balanced ternary
+ *         numbers in tryte (3-trit) representation.
+ *  This is equivalent to calling bytes_to_trytes for each 48-byte integer, but
+ *  converts several integers at once.
+ *  @param bytes input of num_chunks big-endian 48-byte integers
+ *  @param trytes target tryte array of num_chunks * 81 trytes
+ *  @param num_chunks number of integers to convert
+ */
+void bytes_to_trytes_n(const unsigned char *bytes, tryte_t *trytes,
+                       unsigned int num_chunks);
+
 /** @brief Converts an array of chars into a big-endian binary integer.
  *  The input must consist of multiples of 81-char chunks, each chunk is
  *  converted into a big-endian 48-byte integer
@@ -79,6 +235,15 @@ void chars_to_bytes(const char *chars, unsigned char *bytes, unsigned int chars_
 int chars_to_trytes(const char chars_in[], tryte_t trytes_out[],
                     unsigned int len);
 
+/** @brief Converts a balanced ternary number in tryte (3-trit) representation
+ *         into base-27 encoding.
+ *  @param trytes_in input tryte array
+ *  @param chars_out target char array
+ *  @param len number of trytes to convert
+ */
+int trytes_to_chars(const tryte_t trytes_in[], char chars_out[],
+                    unsigned int len);
+
 /** @brief Converts a big-endian binary integer into a balanced ternary number
  *         in base-27 encoding.
  *  The input must consist of one or more big-endian 48-byte integers, each
@@ -110,4 +275,11 @@ void bytes_increment_trit_area_81(unsigned char *bytes);
  */
 void bytes_add_u32_mem(unsigned char *bytes, uint32_t summand);
 
+/** @brief Adds one to a 48-byte big-endian integer.
+ *  This is identical to bytes_add_u32_mem(bytes, 1), but only converts into
+ *  a bigint in the rare case that the 243th trit becomes set.
+ *  @param bytes input big-endian 48-byte integer
+ */
+void bytes_increment(unsigned char *bytes);
+
 #endif // CONVERSION_H
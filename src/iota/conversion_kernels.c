@@ -0,0 +1,800 @@
+/** @file conversion_kernels.c
+ *  @brief Conversions between trits and the 48-byte binary representation.
+ *
+ *  These are the bigint and char kernels behind the corresponding functions
+ *  in conversion.h. The file is compiled once for every backend, the per-ISA
+ *  sources conversion_kernels_*.c include it with CONVERSION_KERNEL defined
+ *  to append their own suffix to the exported function names.
+ */
+
+#include "conversion_kernels.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "common.h"
+
+#ifndef CONVERSION_KERNEL
+#define CONVERSION_KERNEL(name) name##_generic
+#endif
+
+// use 64-bit limbs with 128-bit intermediates, if the compiler supports them
+#ifndef USE_BIGINT_64
+#ifdef __SIZEOF_INT128__
+#define USE_BIGINT_64 1
+#else
+#define USE_BIGINT_64 0
+#endif
+#endif
+
+#if USE_BIGINT_64
+typedef uint64_t limb_t;
+typedef unsigned __int128 double_limb_t;
+#define NUM_LIMBS 6
+// number of trits, whose non-balanced value always fits into one limb
+#define TRITS_PER_LIMB 40
+// 3^TRITS_PER_LIMB
+#define LIMB_RADIX UINT64_C(12157665459056928801)
+// number of trytes, whose non-balanced value always fits into one limb
+#define TRYTES_PER_LIMB 13
+// 27^TRYTES_PER_LIMB
+#define LIMB_RADIX_TRYTES UINT64_C(4052555153018976267)
+// combines two 32-bit words of a constant into one limb
+#define LIMBS(lo, hi) ((uint64_t)(hi) << 32 | (lo))
+#else
+typedef uint32_t limb_t;
+typedef uint64_t double_limb_t;
+#define NUM_LIMBS 12
+#define TRITS_PER_LIMB 20
+#define LIMB_RADIX UINT32_C(3486784401)
+#define TRYTES_PER_LIMB 6
+#define LIMB_RADIX_TRYTES UINT32_C(387420489)
+#define LIMBS(lo, hi) (lo), (hi)
+#endif // USE_BIGINT_64
+
+#define LIMB_BITS (sizeof(limb_t) * 8)
+
+// base of the ternary system
+#define BASE 3
+
+// the middle of the domain described by 242 trits, i.e. \sum_{k=0}^{241} 3^k
+static const limb_t HALF_3[NUM_LIMBS] = {
+    LIMBS(0xa5ce8964, 0x9f007669), LIMBS(0x1484504f, 0x3ade00d9),
+    LIMBS(0x0c24486e, 0x50979d57), LIMBS(0x79a4c702, 0x48bbae36),
+    LIMBS(0xa9f6808b, 0xaa06a805), LIMBS(0xa87fabdf, 0x5e69ebef)};
+
+// the two's complement of HALF_3_u, i.e. ~HALF_3_u + 1
+static const limb_t NEG_HALF_3[NUM_LIMBS] = {
+    LIMBS(0x5a31769c, 0x60ff8996), LIMBS(0xeb7bafb0, 0xc521ff26),
+    LIMBS(0xf3dbb791, 0xaf6862a8), LIMBS(0x865b38fd, 0xb74451c9),
+    LIMBS(0x56097f74, 0x55f957fa), LIMBS(0x57805420, 0xa1961410)};
+
+// representing the value of the highes trit in the feasible domain, i.e 3^242
+static const limb_t TRIT_243[NUM_LIMBS] = {
+    LIMBS(0x4b9d12c9, 0x3e00ecd3), LIMBS(0x2908a09f, 0x75bc01b2),
+    LIMBS(0x184890dc, 0xa12f3aae), LIMBS(0xf3498e04, 0x91775c6c),
+    LIMBS(0x53ed0116, 0x540d500b), LIMBS(0x50ff57bf, 0xbcd3d7df)};
+
+// representing the value of the 82nd trit, i.e. 3^81
+static const limb_t TRIT_82[NUM_LIMBS] = {LIMBS(0xd56d7cc3, 0xb6bf0c69),
+                                          LIMBS(0xa149e834, 0x4d98d5ce),
+                                          LIMBS(0x1, 0)};
+
+// representing the value of the 163rd trit, i.e. 3^162
+static const limb_t TRIT_163[NUM_LIMBS] = {
+    LIMBS(0xf8db7c89, 0x786c0065), LIMBS(0x95d05dc0, 0x5cc1c941),
+    LIMBS(0xa7987cba, 0xd6fd8182), LIMBS(0x278b4d09, 0xb2b6f77a),
+    LIMBS(0x1, 0)};
+
+/** @brief Returns true, if the long little-endian integer represents a negative
+ *         number in two's complement.
+ */
+static inline bool bigint_is_negative(const limb_t *bigint)
+{
+    // whether the most significant bit of the most significant byte is set
+    return (bigint[NUM_LIMBS - 1] >> (LIMB_BITS - 1) != 0);
+}
+
+static int bigint_cmp(const limb_t *a, const limb_t *b)
+{
+    for (unsigned int i = NUM_LIMBS; i-- > 0;) {
+        if (a[i] < b[i]) {
+            return -1;
+        }
+        if (a[i] > b[i]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static inline bool addcarry(limb_t *r, limb_t a, limb_t b, bool c_in)
+{
+    // the compiler turns this into a single add-with-carry instruction
+    const double_limb_t sum = (double_limb_t)a + b + c_in;
+
+    *r = (limb_t)sum;
+    return (sum >> LIMB_BITS) != 0;
+}
+
+static bool bigint_add(limb_t *r, const limb_t *a, const limb_t *b)
+{
+    bool carry = false;
+    for (unsigned int i = 0; i < NUM_LIMBS; i++) {
+        carry = addcarry(&r[i], a[i], b[i], carry);
+    }
+
+    return carry;
+}
+
+static bool bigint_sub(limb_t *r, const limb_t *a, const limb_t *b)
+{
+    bool carry = true;
+    for (unsigned int i = 0; i < NUM_LIMBS; i++) {
+        carry = addcarry(&r[i], a[i], ~b[i], carry);
+    }
+
+    return carry;
+}
+
+/** @brief adds a single 32-bit integer to a long little-endian integer.
+ *  @return index of the most significant limb which changed during the
+ *          addition
+ */
+static unsigned int bigint_add_u32_mem(limb_t *a, uint32_t summand)
+{
+    bool carry = addcarry(&a[0], a[0], summand, false);
+    if (carry == false) {
+        return 0;
+    }
+
+    for (unsigned int i = 1; i < NUM_LIMBS; i++) {
+        carry = addcarry(&a[i], a[i], 0, true);
+        if (carry == false) {
+            return i;
+        }
+    }
+
+    // overflow
+    return NUM_LIMBS;
+}
+
+/** @brief multiplies a long little-endian integer with a single limb and
+ *         adds another limb to the product.
+ *  @param ms_index the index of the most significant non-zero limb of the
+ *                  input integer. Limbs after this are not considered.
+ *  @return the carry (one limb) of the operation up to the limb which has the
+ *          index specified in ms_index.
+ */
+static limb_t bigint_mult_add_mem(limb_t *a, limb_t factor, limb_t summand,
+                                  unsigned int ms_index)
+{
+    limb_t carry = summand;
+
+    for (unsigned int i = 0; i <= ms_index; i++) {
+        const double_limb_t v = (double_limb_t)factor * a[i] + carry;
+
+        carry = v >> LIMB_BITS;
+        a[i] = (limb_t)v;
+    }
+
+    return carry;
+}
+
+// number of trits extracted by each division, a multiple of 3 so that each
+// division also yields whole trytes
+#define TRITS_PER_DIVISION 18
+#define TRYTES_PER_DIVISION (TRITS_PER_DIVISION / 3)
+// 3^TRITS_PER_DIVISION, which fits into 32 bits
+#define DIVISION_RADIX UINT32_C(387420489)
+
+/** @brief divides a long little-endian integer by 3^TRITS_PER_DIVISION.
+ *  The division is done in 32-bit steps, so that each step only needs a 64-bit
+ *  division by a constant, which the compiler turns into a multiplication.
+ *  @param ms_index the index of the most significant non-zero limb of the
+ *                  input integer, which is updated for the quotient.
+ *  @return remainder of the integer division.
+ */
+static uint32_t bigint_div_radix_mem(limb_t *a, unsigned int *ms_index)
+{
+    uint64_t remainder = 0;
+
+    for (unsigned int i = *ms_index + 1; i-- > 0;) {
+        limb_t quotient = 0;
+
+        for (unsigned int shift = LIMB_BITS; shift > 0;) {
+            shift -= 32;
+
+            const uint64_t v = remainder << 32 | (uint32_t)(a[i] >> shift);
+            quotient |= (limb_t)(v / DIVISION_RADIX) << shift;
+            remainder = v % DIVISION_RADIX;
+        }
+        a[i] = quotient;
+    }
+
+    while (*ms_index > 0 && a[*ms_index] == 0) {
+        *ms_index -= 1;
+    }
+
+    return remainder;
+}
+
+/** @brief Changes number to the corresponding representation of the number
+ *         with the 242th trit set to 0.
+ * @return true, if the number was changed, false otherwise.
+ */
+static bool bigint_set_last_trit_zero(limb_t *bigint)
+{
+    if (bigint_is_negative(bigint)) {
+        if (bigint_cmp(bigint, NEG_HALF_3) < 0) {
+            bigint_add(bigint, bigint, TRIT_243);
+            return true;
+        }
+    }
+    else {
+        if (bigint_cmp(bigint, HALF_3) > 0) {
+            bigint_sub(bigint, bigint, TRIT_243);
+            return true;
+        }
+    }
+    return false;
+}
+
+/** @brief Converts the non-balanced number into balanced ternary using two's
+ *         complement.
+ */
+static void bigint_from_non_balanced(limb_t *bigint)
+{
+    if (bigint_cmp(bigint, HALF_3) >= 0) {
+        bigint_sub(bigint, bigint, HALF_3);
+    }
+    else {
+        // equivalent to bytes := ~(HALF_3 - bytes) + 1
+        bigint_add(bigint, NEG_HALF_3, bigint);
+    }
+}
+
+/** @brief Converts the balanced number in two's complement into the (positive)
+ *         number representing non-balanced ternary.
+ */
+static void bigint_to_non_balanced(limb_t *bigint)
+{
+    // the two's complement represention is only correct, if the number fits
+    // into 48 bytes, i.e. has the 243th trit set to 0
+    bigint_set_last_trit_zero(bigint);
+
+    if (bigint_is_negative(bigint)) {
+        bigint_sub(bigint, bigint, NEG_HALF_3);
+    }
+    else {
+        bigint_add(bigint, bigint, HALF_3);
+    }
+}
+
+/* --------------------- trits > bigint and back */
+/** @brief Returns the non-balanced value of the given trits as one limb,
+ *         the trit at the highest address being the most significant one.
+ */
+static inline limb_t trits_to_limb(const trit_t *trits, unsigned int num_trits)
+{
+    limb_t digit = 0;
+    for (unsigned int i = num_trits; i-- > 0;) {
+        digit = digit * BASE + (trits[i] + 1);
+    }
+
+    return digit;
+}
+
+static void trits_to_bigint(const trit_t *trits, limb_t *bigint)
+{
+    unsigned int ms_index = 0; // initialy there is no most significant limb >0
+    os_memset(bigint, 0, NUM_LIMBS * sizeof(bigint[0]));
+
+    // ignore the 243th trit, as it cannot be fully represented in 48 bytes,
+    // and evaluate the remaining ones as digits of TRITS_PER_LIMB trits each,
+    // starting with the partial most significant digit
+    unsigned int i = 242 - 242 % TRITS_PER_LIMB;
+    bigint[0] = trits_to_limb(trits + i, 242 % TRITS_PER_LIMB);
+
+    while (i > 0) {
+        i -= TRITS_PER_LIMB;
+
+        const limb_t digit = trits_to_limb(trits + i, TRITS_PER_LIMB);
+        const limb_t carry =
+            bigint_mult_add_mem(bigint, LIMB_RADIX, digit, ms_index);
+        if (carry > 0) {
+            // if there is carry we need to use the next higher limb
+            bigint[++ms_index] = carry;
+        }
+    }
+
+    bigint_from_non_balanced(bigint);
+}
+
+static void bigint_to_trits_mem(limb_t *bigint, trit_t *trits)
+{
+    bigint_to_non_balanced(bigint);
+
+    // ignore the 243th trit, as it cannot be fully represented in 48 bytes
+    unsigned int ms_index = NUM_LIMBS - 1;
+    for (unsigned int i = 0; i < 242; i += TRITS_PER_DIVISION) {
+        uint32_t rem = bigint_div_radix_mem(bigint, &ms_index);
+
+        // split the remainder into single trits
+        const unsigned int end = MIN(i + TRITS_PER_DIVISION, 242);
+        for (unsigned int j = i; j < end; j++) {
+            trits[j] = (int)(rem % BASE) - 1; // convert back to balanced
+            rem /= BASE;
+        }
+    }
+    // set the last trit to zero for consistency
+    trits[242] = 0;
+}
+/* --------------------- END trits > bigint */
+
+/* --------------------- trytes > bigint and back */
+/** @brief Returns the non-balanced value of the given trytes as one limb,
+ *         the tryte at the highest address being the most significant one.
+ */
+static inline limb_t trytes_to_limb(const tryte_t *trytes,
+                                    unsigned int num_trytes)
+{
+    limb_t digit = 0;
+    for (unsigned int i = num_trytes; i-- > 0;) {
+        digit = digit * 27 + (trytes[i] - MIN_TRYTE_VALUE);
+    }
+
+    return digit;
+}
+
+static void trytes_to_bigint(const tryte_t *trytes, limb_t *bigint)
+{
+    unsigned int ms_index = 0; // initialy there is no most significant limb >0
+    os_memset(bigint, 0, NUM_LIMBS * sizeof(bigint[0]));
+
+    // ignore the 243th trit, i.e. only use the two lower trits of the most
+    // significant tryte, and evaluate the remaining ones as digits of
+    // TRYTES_PER_LIMB trytes each, starting with the partial most significant
+    // digit
+    unsigned int i = 80 - 80 % TRYTES_PER_LIMB;
+    limb_t digit = (trytes[80] - MIN_TRYTE_VALUE) % 9;
+    for (unsigned int j = 80; j-- > i;) {
+        digit = digit * 27 + (trytes[j] - MIN_TRYTE_VALUE);
+    }
+    bigint[0] = digit;
+
+    while (i > 0) {
+        i -= TRYTES_PER_LIMB;
+
+        digit = trytes_to_limb(trytes + i, TRYTES_PER_LIMB);
+        const limb_t carry =
+            bigint_mult_add_mem(bigint, LIMB_RADIX_TRYTES, digit, ms_index);
+        if (carry > 0) {
+            // if there is carry we need to use the next higher limb
+            bigint[++ms_index] = carry;
+        }
+    }
+
+    bigint_from_non_balanced(bigint);
+}
+
+static void bigint_to_trytes_mem(limb_t *bigint, tryte_t *trytes)
+{
+    bigint_to_non_balanced(bigint);
+
+    unsigned int ms_index = NUM_LIMBS - 1;
+    for (unsigned int i = 0; i < 81; i += TRYTES_PER_DIVISION) {
+        uint32_t rem = bigint_div_radix_mem(bigint, &ms_index);
+
+        // split the remainder into single trytes
+        const unsigned int end = MIN(i + TRYTES_PER_DIVISION, 81);
+        for (unsigned int j = i; j < end; j++) {
+            // convert back to balanced
+            trytes[j] = (int)(rem % 27) + MIN_TRYTE_VALUE;
+            rem /= 27;
+        }
+    }
+    // the number only contains the two lower trits of the most significant
+    // tryte, its 243th trit is zero, i.e. 1 in non-balanced ternary
+    trytes[80] += 9;
+}
+/* --------------------- END trytes > bigint */
+
+/** @brief Converts a bigint into an array of bytes.
+ *  It is represented using 48bytes in big-endiean, by reversing the order of
+ *  the limbs. The endianness of the host machine is taken into account.
+ */
+static void bigint_to_bytes(const limb_t *bigint, unsigned char *bytes)
+{
+    // reverse limb order
+    for (unsigned int i = NUM_LIMBS; i-- > 0;) {
+        const limb_t num = bigint[i];
+
+        for (unsigned int j = sizeof(limb_t); j-- > 0;) {
+            *bytes++ = (num >> (8 * j)) & 0xFF;
+        }
+    }
+}
+
+/** @brief Converts an array of 48 bytes into a bigint.
+ *  The bigint is represented using 48bytes in big-endiean. The endianness of
+ * the host machine is taken into account.
+ */
+static void bytes_to_bigint(const unsigned char *bytes, limb_t *bigint)
+{
+    // reverse limb order
+    for (unsigned int i = NUM_LIMBS; i-- > 0;) {
+        limb_t num = 0;
+
+        for (unsigned int j = 0; j < sizeof(limb_t); j++) {
+            num = num << 8 | *bytes++;
+        }
+        bigint[i] = num;
+    }
+}
+
+void CONVERSION_KERNEL(trits_to_bytes)(const trit_t *trits,
+                                       unsigned char *bytes)
+{
+    limb_t bigint[NUM_LIMBS];
+    trits_to_bigint(trits, bigint);
+    bigint_to_bytes(bigint, bytes);
+}
+
+void CONVERSION_KERNEL(bytes_to_trits)(const unsigned char *bytes,
+                                       trit_t *trits)
+{
+    limb_t bigint[NUM_LIMBS];
+    bytes_to_bigint(bytes, bigint);
+    bigint_to_trits_mem(bigint, trits);
+}
+
+void CONVERSION_KERNEL(trytes_to_bytes)(const tryte_t *trytes,
+                                        unsigned char *bytes)
+{
+    limb_t bigint[NUM_LIMBS];
+    trytes_to_bigint(trytes, bigint);
+    bigint_to_bytes(bigint, bytes);
+}
+
+void CONVERSION_KERNEL(bytes_to_trytes)(const unsigned char *bytes,
+                                        tryte_t *trytes)
+{
+    limb_t bigint[NUM_LIMBS];
+    bytes_to_bigint(bytes, bigint);
+    bigint_to_trytes_mem(bigint, trytes);
+}
+
+void CONVERSION_KERNEL(bytes_set_last_trit_zero)(unsigned char *bytes)
+{
+    limb_t bigint[NUM_LIMBS];
+    bytes_to_bigint(bytes, bigint);
+    if (bigint_set_last_trit_zero(bigint)) {
+        bigint_to_bytes(bigint, bytes);
+    }
+}
+
+/** @brief Returns whether the trits 82 to 162 of the non-balanced number are
+ *         all 2, i.e. whether incrementing the 82nd trit overflows the area.
+ *  The remainders are extracted from the least significant trit on, so that
+ *  usually the first trit of the area already decides. The number is
+ *  destroyed.
+ */
+static bool bigint_trit_area_81_is_max(limb_t *bigint)
+{
+    unsigned int ms_index = NUM_LIMBS - 1;
+    for (unsigned int i = 0; i < 162; i += TRITS_PER_DIVISION) {
+        uint32_t rem = bigint_div_radix_mem(bigint, &ms_index);
+        if (i + TRITS_PER_DIVISION <= 81) {
+            continue;
+        }
+
+        for (unsigned int j = i; j < i + TRITS_PER_DIVISION; j++, rem /= BASE) {
+            if (j >= 81 && rem % BASE != 2) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void CONVERSION_KERNEL(bytes_increment_trit_area_81)(unsigned char *bytes)
+{
+    limb_t bigint[NUM_LIMBS];
+    bytes_to_bigint(bytes, bigint);
+    // the 243th trit is not part of the result
+    bigint_set_last_trit_zero(bigint);
+
+    limb_t non_balanced[NUM_LIMBS];
+    os_memcpy(non_balanced, bigint, sizeof(non_balanced));
+    bigint_to_non_balanced(non_balanced);
+
+    bigint_add(bigint, bigint, TRIT_82);
+    if (bigint_trit_area_81_is_max(non_balanced)) {
+        // the area wraps around to all -1 without carrying into the 163rd trit
+        bigint_sub(bigint, bigint, TRIT_163);
+    }
+    bigint_to_bytes(bigint, bytes);
+}
+
+void CONVERSION_KERNEL(bytes_add_u32_mem)(unsigned char *bytes,
+                                          uint32_t summand)
+{
+    if (summand > 0) {
+        limb_t bigint[NUM_LIMBS];
+
+        bytes_to_bigint(bytes, bigint);
+        bigint_add_u32_mem(bigint, summand);
+        bigint_set_last_trit_zero(bigint);
+        bigint_to_bytes(bigint, bytes);
+    }
+}
+
+/* --------------------- batches of chunks */
+// number of chunks converted together, so that their independent carry and
+// remainder chains can be executed in parallel
+#define BATCH_LANES 4
+
+/** @brief multiplies BATCH_LANES long little-endian integers, stored limb by
+ *         limb, with a single limb and adds a different limb to each product.
+ *  @param ms_index the index of the most significant non-zero limb of all
+ *                  integers, which is updated for the result.
+ */
+static void bigint_mult_add_lanes(limb_t (*a)[BATCH_LANES], limb_t factor,
+                                  const limb_t *summands,
+                                  unsigned int *ms_index)
+{
+    limb_t carry[BATCH_LANES];
+    os_memcpy(carry, summands, sizeof(carry));
+
+    for (unsigned int i = 0; i <= *ms_index; i++) {
+        for (unsigned int l = 0; l < BATCH_LANES; l++) {
+            const double_limb_t v = (double_limb_t)factor * a[i][l] + carry[l];
+
+            carry[l] = v >> LIMB_BITS;
+            a[i][l] = (limb_t)v;
+        }
+    }
+
+    limb_t any_carry = 0;
+    for (unsigned int l = 0; l < BATCH_LANES; l++) {
+        any_carry |= carry[l];
+    }
+    if (any_carry > 0) {
+        // if there is carry we need to use the next higher limb
+        *ms_index += 1;
+        os_memcpy(a[*ms_index], carry, sizeof(carry));
+    }
+}
+
+/** @brief divides BATCH_LANES long little-endian integers, stored limb by
+ *         limb, by 3^TRITS_PER_DIVISION, see bigint_div_radix_mem.
+ *  @param remainders target array of the BATCH_LANES remainders
+ *  @param ms_index the index of the most significant non-zero limb of all
+ *                  integers, which is updated for the quotients.
+ */
+static void bigint_div_radix_lanes(limb_t (*a)[BATCH_LANES],
+                                   uint32_t *remainders,
+                                   unsigned int *ms_index)
+{
+    uint64_t remainder[BATCH_LANES] = {0};
+
+    for (unsigned int i = *ms_index + 1; i-- > 0;) {
+        limb_t quotient[BATCH_LANES] = {0};
+
+        for (unsigned int shift = LIMB_BITS; shift > 0;) {
+            shift -= 32;
+
+            for (unsigned int l = 0; l < BATCH_LANES; l++) {
+                const uint64_t v =
+                    remainder[l] << 32 | (uint32_t)(a[i][l] >> shift);
+                quotient[l] |= (limb_t)(v / DIVISION_RADIX) << shift;
+                remainder[l] = v % DIVISION_RADIX;
+            }
+        }
+        os_memcpy(a[i], quotient, sizeof(quotient));
+    }
+
+    for (; *ms_index > 0; *ms_index -= 1) {
+        limb_t any_limb = 0;
+        for (unsigned int l = 0; l < BATCH_LANES; l++) {
+            any_limb |= a[*ms_index][l];
+        }
+        if (any_limb > 0) {
+            break;
+        }
+    }
+
+    for (unsigned int l = 0; l < BATCH_LANES; l++) {
+        remainders[l] = remainder[l];
+    }
+}
+
+void CONVERSION_KERNEL(trits_to_bytes_n)(const trit_t *trits,
+                                         unsigned char *bytes,
+                                         unsigned int num_chunks)
+{
+    unsigned int k = 0;
+    for (; k + BATCH_LANES <= num_chunks; k += BATCH_LANES) {
+        const trit_t *chunks = trits + k * 243;
+
+        limb_t lanes[NUM_LIMBS][BATCH_LANES];
+        limb_t digits[BATCH_LANES];
+        unsigned int ms_index = 0;
+        os_memset(lanes, 0, sizeof(lanes));
+
+        // see trits_to_bigint
+        unsigned int i = 242 - 242 % TRITS_PER_LIMB;
+        for (unsigned int l = 0; l < BATCH_LANES; l++) {
+            lanes[0][l] =
+                trits_to_limb(chunks + l * 243 + i, 242 % TRITS_PER_LIMB);
+        }
+
+        while (i > 0) {
+            i -= TRITS_PER_LIMB;
+
+            for (unsigned int l = 0; l < BATCH_LANES; l++) {
+                digits[l] =
+                    trits_to_limb(chunks + l * 243 + i, TRITS_PER_LIMB);
+            }
+            bigint_mult_add_lanes(lanes, LIMB_RADIX, digits, &ms_index);
+        }
+
+        for (unsigned int l = 0; l < BATCH_LANES; l++) {
+            limb_t bigint[NUM_LIMBS];
+            for (unsigned int j = 0; j < NUM_LIMBS; j++) {
+                bigint[j] = lanes[j][l];
+            }
+            bigint_from_non_balanced(bigint);
+            bigint_to_bytes(bigint, bytes + (k + l) * 48);
+        }
+    }
+
+    for (; k < num_chunks; k++) {
+        CONVERSION_KERNEL(trits_to_bytes)(trits + k * 243, bytes + k * 48);
+    }
+}
+
+void CONVERSION_KERNEL(bytes_to_trytes_n)(const unsigned char *bytes,
+                                          tryte_t *trytes,
+                                          unsigned int num_chunks)
+{
+    unsigned int k = 0;
+    for (; k + BATCH_LANES <= num_chunks; k += BATCH_LANES) {
+        tryte_t *chunks = trytes + k * 81;
+
+        limb_t lanes[NUM_LIMBS][BATCH_LANES];
+        for (unsigned int l = 0; l < BATCH_LANES; l++) {
+            limb_t bigint[NUM_LIMBS];
+            bytes_to_bigint(bytes + (k + l) * 48, bigint);
+            bigint_to_non_balanced(bigint);
+
+            for (unsigned int j = 0; j < NUM_LIMBS; j++) {
+                lanes[j][l] = bigint[j];
+            }
+        }
+
+        // see bigint_to_trytes_mem
+        unsigned int ms_index = NUM_LIMBS - 1;
+        for (unsigned int i = 0; i < 81; i += TRYTES_PER_DIVISION) {
+            uint32_t rem[BATCH_LANES];
+            bigint_div_radix_lanes(lanes, rem, &ms_index);
+
+            const unsigned int end = MIN(i + TRYTES_PER_DIVISION, 81);
+            for (unsigned int l = 0; l < BATCH_LANES; l++) {
+                for (unsigned int j = i; j < end; j++) {
+                    chunks[l * 81 + j] = (int)(rem[l] % 27) + MIN_TRYTE_VALUE;
+                    rem[l] /= 27;
+                }
+            }
+        }
+        for (unsigned int l = 0; l < BATCH_LANES; l++) {
+            chunks[l * 81 + 80] += 9;
+        }
+    }
+
+    for (; k < num_chunks; k++) {
+        CONVERSION_KERNEL(bytes_to_trytes)(bytes + k * 48, trytes + k * 81);
+    }
+}
+/* --------------------- END batches of chunks */
+
+/* --------------------- chars > trytes and back */
+#ifdef __AVX2__
+#include <immintrin.h>
+
+// number of chars handled by one vector
+#define CHARS_PER_VECTOR 32
+#endif // __AVX2__
+
+void CONVERSION_KERNEL(chars_to_trytes)(const char *chars, tryte_t *trytes,
+                                        unsigned int len)
+{
+    unsigned int i = 0;
+#ifdef __AVX2__
+    for (; i + CHARS_PER_VECTOR <= len; i += CHARS_PER_VECTOR) {
+        const __m256i c = _mm256_loadu_si256((const __m256i *)(chars + i));
+
+        // 'A'..'M' map to 1..13, 'N'..'Z' to -13..-1 and '9' to 0
+        __m256i t = _mm256_sub_epi8(c, _mm256_set1_epi8(64));
+        const __m256i n = _mm256_cmpgt_epi8(c, _mm256_set1_epi8('M'));
+        t = _mm256_sub_epi8(t, _mm256_and_si256(n, _mm256_set1_epi8(27)));
+        const __m256i nine = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('9'));
+        t = _mm256_andnot_si256(nine, t);
+
+        _mm256_storeu_si256((__m256i *)(trytes + i), t);
+    }
+#endif // __AVX2__
+    for (; i < len; i++) {
+        const int8_t c = chars[i];
+        if (c == '9') {
+            trytes[i] = 0;
+        }
+        else if (c >= 'N') {
+            trytes[i] = c - 64 - 27;
+        }
+        else {
+            trytes[i] = c - 64;
+        }
+    }
+}
+
+void CONVERSION_KERNEL(trytes_to_chars)(const tryte_t *trytes, char *chars,
+                                        unsigned int len)
+{
+    // available tryte chars in the correct order
+    static const char tryte_to_char_mapping[] = "NOPQRSTUVWXYZ9ABCDEFGHIJKLM";
+
+    unsigned int i = 0;
+#ifdef __AVX2__
+    // the mapping split into two 16-byte lookup tables for pshufb
+    const __m256i lo = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)tryte_to_char_mapping));
+    const __m256i hi = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+        'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 0, 0, 0, 0, 0));
+
+    for (; i + CHARS_PER_VECTOR <= len; i += CHARS_PER_VECTOR) {
+        const __m256i t = _mm256_loadu_si256((const __m256i *)(trytes + i));
+
+        const __m256i idx = _mm256_add_epi8(t, _mm256_set1_epi8(13));
+        const __m256i is_hi = _mm256_cmpgt_epi8(idx, _mm256_set1_epi8(15));
+        const __m256i c = _mm256_blendv_epi8(
+            _mm256_shuffle_epi8(lo, idx),
+            _mm256_shuffle_epi8(hi, _mm256_sub_epi8(idx, _mm256_set1_epi8(16))),
+            is_hi);
+
+        _mm256_storeu_si256((__m256i *)(chars + i), c);
+    }
+#endif // __AVX2__
+    for (; i < len; i++) {
+        chars[i] = tryte_to_char_mapping[trytes[i] + 13];
+    }
+}
+
+bool CONVERSION_KERNEL(validate_chars)(const char *chars, unsigned int len)
+{
+    unsigned int i = 0;
+#ifdef __AVX2__
+    for (; i + CHARS_PER_VECTOR <= len; i += CHARS_PER_VECTOR) {
+        const __m256i c = _mm256_loadu_si256((const __m256i *)(chars + i));
+
+        // shift 'A'..'Z' to the smallest signed bytes for a single comparison
+        const __m256i shifted = _mm256_sub_epi8(c, _mm256_set1_epi8('A' - 128));
+        const __m256i letter =
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), shifted);
+        const __m256i nine = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('9'));
+
+        if (_mm256_movemask_epi8(_mm256_or_si256(letter, nine)) != -1) {
+            return false;
+        }
+    }
+#endif // __AVX2__
+    for (; i < len; i++) {
+        const char c = chars[i];
+        if (c != '9' && (c < 'A' || c > 'Z')) {
+            return false;
+        }
+    }
+
+    return true;
+}
+/* --------------------- END chars > trytes */
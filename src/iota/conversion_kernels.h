@@ -0,0 +1,39 @@
+/** @file conversion_kernels.h
+ *  @brief Per-backend variants of the bigint and char conversion kernels.
+ *
+ *  Use the functions in conversion.h instead, they call the variant of the
+ *  backend selected in dispatch.h.
+ */
+
+#ifndef CONVERSION_KERNELS_H
+#define CONVERSION_KERNELS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "iota_types.h"
+
+#define DECLARE_CONVERSION_KERNELS(suffix)                                     \
+    void trits_to_bytes_##suffix(const trit_t *trits, unsigned char *bytes);   \
+    void bytes_to_trits_##suffix(const unsigned char *bytes, trit_t *trits);   \
+    void trytes_to_bytes_##suffix(const tryte_t *trytes,                       \
+                                  unsigned char *bytes);                       \
+    void bytes_to_trytes_##suffix(const unsigned char *bytes,                  \
+                                  tryte_t *trytes);                            \
+    void bytes_set_last_trit_zero_##suffix(unsigned char *bytes);              \
+    void bytes_increment_trit_area_81_##suffix(unsigned char *bytes);          \
+    void bytes_add_u32_mem_##suffix(unsigned char *bytes, uint32_t summand);   \
+    void chars_to_trytes_##suffix(const char *chars, tryte_t *trytes,          \
+                                  unsigned int len);                           \
+    void trytes_to_chars_##suffix(const tryte_t *trytes, char *chars,          \
+                                  unsigned int len);                           \
+    bool validate_chars_##suffix(const char *chars, unsigned int len);         \
+    void trits_to_bytes_n_##suffix(const trit_t *trits, unsigned char *bytes,  \
+                                   unsigned int num_chunks);                   \
+    void bytes_to_trytes_n_##suffix(const unsigned char *bytes,                \
+                                    tryte_t *trytes, unsigned int num_chunks);
+
+DECLARE_CONVERSION_KERNELS(generic)
+DECLARE_CONVERSION_KERNELS(avx2)
+DECLARE_CONVERSION_KERNELS(avx512)
+
+#endif // CONVERSION_KERNELS_H
@@ -0,0 +1,12 @@
+/** @file conversion_kernels_avx2.c
+ *  @brief Bigint conversion kernels compiled for AVX2 and BMI2.
+ */
+
+#include "conversion_kernels.h"
+
+#if defined(__AVX2__) && defined(__BMI2__)
+
+#define CONVERSION_KERNEL(name) name##_avx2
+#include "conversion_kernels.c"
+
+#endif // __AVX2__ && __BMI2__
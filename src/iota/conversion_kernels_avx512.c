@@ -0,0 +1,12 @@
+/** @file conversion_kernels_avx512.c
+ *  @brief Bigint conversion kernels compiled for AVX-512 and BMI2.
+ */
+
+#include "conversion_kernels.h"
+
+#if defined(__AVX512F__) && defined(__BMI2__)
+
+#define CONVERSION_KERNEL(name) name##_avx512
+#include "conversion_kernels.c"
+
+#endif // __AVX512F__ && __BMI2__
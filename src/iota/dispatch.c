@@ -0,0 +1,126 @@
+#include "dispatch.h"
+#include "common.h"
+#include "conversion_kernels.h"
+
+static const BACKEND GENERIC = {"generic",
+                                sha3_permutation,
+                                sha3_permutation_x2,
+                                sha3_permutation_x4,
+                                sha3_permutation_x8,
+                                2,
+                                trits_to_bytes_generic,
+                                bytes_to_trits_generic,
+                                trytes_to_bytes_generic,
+                                bytes_to_trytes_generic,
+                                trits_to_bytes_n_generic,
+                                bytes_to_trytes_n_generic,
+                                bytes_set_last_trit_zero_generic,
+                                bytes_increment_trit_area_81_generic,
+                                bytes_add_u32_mem_generic,
+                                chars_to_trytes_generic,
+                                trytes_to_chars_generic,
+                                validate_chars_generic};
+
+#if USE_X86_BACKENDS
+static const BACKEND AVX2 = {"avx2",
+                             sha3_permutation_unrolled_bmi2,
+                             sha3_permutation_x2_bmi2,
+                             sha3_permutation_x4_avx2,
+                             sha3_permutation_x8_avx2,
+                             4,
+                             trits_to_bytes_avx2,
+                             bytes_to_trits_avx2,
+                             trytes_to_bytes_avx2,
+                             bytes_to_trytes_avx2,
+                             trits_to_bytes_n_avx2,
+                             bytes_to_trytes_n_avx2,
+                             bytes_set_last_trit_zero_avx2,
+                             bytes_increment_trit_area_81_avx2,
+                             bytes_add_u32_mem_avx2,
+                             chars_to_trytes_avx2,
+                             trytes_to_chars_avx2,
+                             validate_chars_avx2};
+
+static const BACKEND AVX512 = {"avx512",
+                               sha3_permutation_unrolled_bmi2,
+                               sha3_permutation_x2_bmi2,
+                               sha3_permutation_x4_avx2,
+                               sha3_permutation_x8_avx512,
+                               8,
+                               trits_to_bytes_avx512,
+                               bytes_to_trits_avx512,
+                               trytes_to_bytes_avx512,
+                               bytes_to_trytes_avx512,
+                               trits_to_bytes_n_avx512,
+                               bytes_to_trytes_n_avx512,
+                               bytes_set_last_trit_zero_avx512,
+                               bytes_increment_trit_area_81_avx512,
+                               bytes_add_u32_mem_avx512,
+                               chars_to_trytes_avx512,
+                               trytes_to_chars_avx512,
+                               validate_chars_avx512};
+#endif // USE_X86_BACKENDS
+
+// the generic backend is usable before the CPU features have been detected
+const BACKEND *dispatch = &GENERIC;
+
+/** @brief Returns the backend with the given name, if it is supported. */
+static const BACKEND *find_backend(const char *name)
+{
+    if (strcmp(name, GENERIC.name) == 0) {
+        return &GENERIC;
+    }
+#if USE_X86_BACKENDS
+    __builtin_cpu_init();
+
+    const bool has_bmi2 =
+        __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2");
+    if (strcmp(name, AVX2.name) == 0) {
+        return has_bmi2 && __builtin_cpu_supports("avx2") ? &AVX2 : NULL;
+    }
+    if (strcmp(name, AVX512.name) == 0) {
+        return has_bmi2 && __builtin_cpu_supports("avx2") &&
+                       __builtin_cpu_supports("avx512f")
+                   ? &AVX512
+                   : NULL;
+    }
+#endif // USE_X86_BACKENDS
+    return NULL;
+}
+
+bool dispatch_is_supported(const char *name)
+{
+    return find_backend(name) != NULL;
+}
+
+bool dispatch_select(const char *name)
+{
+    const BACKEND *backend = find_backend(name);
+    if (backend == NULL) {
+        return false;
+    }
+
+    dispatch = backend;
+    return true;
+}
+
+// detect the CPU features once when the program is loaded
+__attribute__((constructor)) static void dispatch_initialize(void)
+{
+    const char *name = getenv(DISPATCH_ENV);
+    if (name != NULL) {
+        if (dispatch_select(name)) {
+            return;
+        }
+        fprintf(stderr, "%s: backend \"%s\" is not supported\n", DISPATCH_ENV,
+                name);
+    }
+
+    // the backends from the fastest to the slowest
+    static const char *const NAMES[] = {"avx512", "avx2", "generic"};
+    for (unsigned int i = 0; i < sizeof(NAMES) / sizeof(NAMES[0]); i++) {
+        if (dispatch_select(NAMES[i])) {
+            return;
+        }
+    }
+}
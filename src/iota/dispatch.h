@@ -0,0 +1,74 @@
+/** @file dispatch.h
+ *  @brief Runtime selection of the Keccak and conversion kernels.
+ *
+ *  All kernels exist in several variants, one per backend. The best backend
+ *  supported by the CPU is selected once at startup. Setting the environment
+ *  variable IOTA_BACKEND to a backend name forces that backend instead.
+ */
+
+#ifndef DISPATCH_H
+#define DISPATCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "iota_types.h"
+
+// the x86 backends need their sources to be compiled with the corresponding
+// instruction set enabled, so they must be explicitly turned on by the build
+#ifndef USE_X86_BACKENDS
+#define USE_X86_BACKENDS 0
+#endif
+
+// environment variable to force a backend, e.g. IOTA_BACKEND=generic
+#define DISPATCH_ENV "IOTA_BACKEND"
+
+typedef struct BACKEND {
+        const char *name; // one of "generic", "avx2" or "avx512"
+
+        // Keccak-f[1600] permutations of one, two, four and eight states
+        void (*keccak_permutation)(uint64_t *state);
+        void (*keccak_permutation_x2)(uint64_t *state);
+        void (*keccak_permutation_x4)(uint64_t *state);
+        void (*keccak_permutation_x8)(uint64_t *state);
+        // number of states that are permuted most efficiently at once
+        unsigned int keccak_lanes;
+
+        // bigint conversions, see conversion.h
+        void (*trits_to_bytes)(const trit_t *trits, unsigned char *bytes);
+        void (*bytes_to_trits)(const unsigned char *bytes, trit_t *trits);
+        void (*trytes_to_bytes)(const tryte_t *trytes, unsigned char *bytes);
+        void (*bytes_to_trytes)(const unsigned char *bytes, tryte_t *trytes);
+        void (*trits_to_bytes_n)(const trit_t *trits, unsigned char *bytes,
+                                 unsigned int num_chunks);
+        void (*bytes_to_trytes_n)(const unsigned char *bytes, tryte_t *trytes,
+                                  unsigned int num_chunks);
+        void (*bytes_set_last_trit_zero)(unsigned char *bytes);
+        void (*bytes_increment_trit_area_81)(unsigned char *bytes);
+        void (*bytes_add_u32_mem)(unsigned char *bytes, uint32_t summand);
+
+        // char conversions, see conversion.h, and the validation of exactly
+        // len chars, see validate_chars in aux.h
+        void (*chars_to_trytes)(const char *chars, tryte_t *trytes,
+                                unsigned int len);
+        void (*trytes_to_chars)(const tryte_t *trytes, char *chars,
+                                unsigned int len);
+        bool (*validate_chars)(const char *chars, unsigned int len);
+} BACKEND;
+
+/** @brief Kernels of the currently selected backend. */
+extern const BACKEND *dispatch;
+
+/** @brief Returns whether the backend is built and supported by the CPU.
+ *  @param name name of the backend
+ */
+bool dispatch_is_supported(const char *name);
+
+/** @brief Selects the backend used by all following computations.
+ *  This is not thread-safe and must not be called while other threads use
+ *  any of the kernels.
+ *  @param name name of the backend
+ *  @return true, if the backend was selected, false if it is not supported
+ */
+bool dispatch_select(const char *name);
+
+#endif // DISPATCH_H
@@ -1,48 +1,84 @@
 #include "kerl.h"
 #include "conversion.h"
 #include "common.h"
+#include "dispatch.h"
 
-void kerl_initialize(cx_sha3_t *sha3)
+#define KERL_RATE_WORDS (SHA3_384_BLOCK_LENGTH / 8)
+#define KERL_CHUNK_WORDS (CX_KECCAK384_SIZE / 8)
+
+void kerl_initialize(KERL_CTX *ctx)
 {
-    cx_keccak_init(sha3, 384);
+    os_memset(ctx, 0, sizeof(KERL_CTX));
 }
 
-void kerl_reinitialize(cx_sha3_t *sha3, const unsigned char *state_bytes)
+void kerl_reinitialize(KERL_CTX *ctx, const unsigned char *state_bytes)
 {
-    kerl_initialize(sha3);
-    kerl_absorb_chunk(sha3, state_bytes);
+    kerl_initialize(ctx);
+    kerl_absorb_chunk(ctx, state_bytes);
 }
 
-void kerl_absorb_bytes(cx_sha3_t *sha3, const unsigned char *bytes,
+void kerl_absorb_bytes(KERL_CTX *ctx, const unsigned char *bytes,
                        unsigned int len)
 {
-    cx_hash((cx_hash_t *)sha3, 0, (unsigned char *)bytes, len, NULL);
+    // the byte order of the lanes is little-endian, same as the host
+    unsigned char *block = (unsigned char *)ctx->state;
+
+    while (len > 0) {
+        const unsigned int n = MIN(len, SHA3_384_BLOCK_LENGTH - ctx->rest);
+
+        for (unsigned int i = 0; i < n; i++) {
+            block[ctx->rest + i] ^= bytes[i];
+        }
+        bytes += n;
+        len -= n;
+
+        ctx->rest += n;
+        if (ctx->rest == SHA3_384_BLOCK_LENGTH) {
+            dispatch->keccak_permutation(ctx->state);
+            ctx->rest = 0;
+        }
+    }
+}
+
+void kerl_absorb_chunk(KERL_CTX *ctx, const unsigned char *bytes)
+{
+    kerl_absorb_bytes(ctx, bytes, CX_KECCAK384_SIZE);
 }
 
-void kerl_absorb_chunk(cx_sha3_t *sha3, const unsigned char *bytes)
+/** @brief Pads and permutes the last block and writes the 48 byte result.
+ *  The context is reset, identical to keccak_Final().
+ */
+static void kerl_final(KERL_CTX *ctx, unsigned char *bytes_out)
 {
-    kerl_absorb_bytes(sha3, bytes, CX_KECCAK384_SIZE);
+    unsigned char *block = (unsigned char *)ctx->state;
+
+    block[ctx->rest] ^= 0x01;
+    block[SHA3_384_BLOCK_LENGTH - 1] ^= 0x80;
+    dispatch->keccak_permutation(ctx->state);
+
+    os_memcpy(bytes_out, ctx->state, CX_KECCAK384_SIZE);
+    kerl_initialize(ctx);
 }
 
-void kerl_squeeze_final_chunk(cx_sha3_t *sha3, unsigned char *bytes_out)
+void kerl_squeeze_final_chunk(KERL_CTX *ctx, unsigned char *bytes_out)
 {
-    cx_hash((cx_hash_t *)sha3, CX_LAST, bytes_out, 0, bytes_out);
+    kerl_final(ctx, bytes_out);
     bytes_set_last_trit_zero(bytes_out);
 }
 
-void kerl_squeeze_chunk(cx_sha3_t *sha3, unsigned char *bytes_out)
+void kerl_squeeze_chunk(KERL_CTX *ctx, unsigned char *bytes_out)
 {
     unsigned char state_bytes[CX_KECCAK384_SIZE];
 
-    kerl_state_squeeze_chunk(sha3, state_bytes, bytes_out);
-    kerl_reinitialize(sha3, state_bytes);
+    kerl_state_squeeze_chunk(ctx, state_bytes, bytes_out);
+    kerl_reinitialize(ctx, state_bytes);
 }
 
-void kerl_squeeze_bytes(cx_sha3_t *sha3, unsigned char *bytes, unsigned int len)
+void kerl_squeeze_bytes(KERL_CTX *ctx, unsigned char *bytes, unsigned int len)
 {
     // absorbing happens in 48 word bigint chunks
     for (unsigned int i = 0; i < (len / CX_KECCAK384_SIZE); i++) {
-        kerl_squeeze_chunk(sha3, bytes + CX_KECCAK384_SIZE * i);
+        kerl_squeeze_chunk(ctx, bytes + CX_KECCAK384_SIZE * i);
     }
 }
 
@@ -53,10 +89,10 @@ static inline void flip_hash_bytes(unsigned char *bytes)
     }
 }
 
-void kerl_state_squeeze_chunk(cx_sha3_t *sha3, unsigned char *state_bytes,
+void kerl_state_squeeze_chunk(KERL_CTX *ctx, unsigned char *state_bytes,
                               unsigned char *bytes_out)
 {
-    cx_hash((cx_hash_t *)sha3, CX_LAST, state_bytes, 0, state_bytes);
+    kerl_final(ctx, state_bytes);
 
     os_memcpy(bytes_out, state_bytes, CX_KECCAK384_SIZE);
     bytes_set_last_trit_zero(bytes_out);
@@ -64,3 +100,304 @@ void kerl_state_squeeze_chunk(cx_sha3_t *sha3, unsigned char *state_bytes,
     // flip bytes for multiple squeeze
     flip_hash_bytes(state_bytes);
 }
+
+/** @brief Writes the padded single block of each chunk into its state.
+ *  Chunk j is stored in the words chunks[KERL_CHUNK_WORDS * j ...]. The
+ *  result is identical to absorbing the chunk into a zero state followed by
+ *  the padding of keccak_Final().
+ */
+static inline void lanes_single_block(uint64_t *state, unsigned int lanes,
+                                      const uint64_t *chunks)
+{
+    os_memset(state + lanes * KERL_CHUNK_WORDS, 0,
+              lanes * (sha3_max_permutation_size - KERL_CHUNK_WORDS) *
+                  sizeof(state[0]));
+
+    for (unsigned int j = 0; j < lanes; j++) {
+        for (unsigned int i = 0; i < KERL_CHUNK_WORDS; i++) {
+            state[lanes * i + j] = chunks[KERL_CHUNK_WORDS * j + i];
+        }
+        state[lanes * KERL_CHUNK_WORDS + j] = 0x01;
+        state[lanes * (KERL_RATE_WORDS - 1) + j] = UINT64_C(1) << 63;
+    }
+}
+
+void kerl_hash_chunk(const unsigned char *bytes, unsigned char *bytes_out)
+{
+    os_memmove(bytes_out, bytes, CX_KECCAK384_SIZE);
+    kerl_chain(bytes_out, 1);
+}
+
+void kerl_chain(unsigned char *bytes, unsigned int n)
+{
+    uint64_t chunk[KERL_CHUNK_WORDS];
+    uint64_t state[sha3_max_permutation_size];
+
+    // the chunk is only converted from and to bytes once for the whole chain
+    os_memcpy(chunk, bytes, CX_KECCAK384_SIZE);
+
+    for (unsigned int k = 0; k < n; k++) {
+        lanes_single_block(state, 1, chunk);
+        dispatch->keccak_permutation(state);
+
+        os_memcpy(chunk, state, CX_KECCAK384_SIZE);
+        bytes_set_last_trit_zero((unsigned char *)chunk);
+    }
+
+    os_memcpy(bytes, chunk, CX_KECCAK384_SIZE);
+}
+
+/* --------------------- multi-lane Kerl */
+
+static void lanes_absorb_chunk(uint64_t *state, unsigned int *rest,
+                               unsigned int lanes, const unsigned char *bytes,
+                               void (*permutation)(uint64_t *))
+{
+    for (unsigned int i = 0; i < KERL_CHUNK_WORDS; i++) {
+        uint64_t *words = state + lanes * *rest;
+
+        for (unsigned int j = 0; j < lanes; j++) {
+            uint64_t word;
+            os_memcpy(&word, bytes + j * CX_KECCAK384_SIZE + i * 8, 8);
+            words[j] ^= word;
+        }
+
+        if (++*rest == KERL_RATE_WORDS) {
+            permutation(state);
+            *rest = 0;
+        }
+    }
+}
+
+/** @brief Pads and permutes the last block of each instance. */
+static inline void lanes_pad_permute(uint64_t *state, unsigned int rest,
+                                     unsigned int lanes,
+                                     void (*permutation)(uint64_t *))
+{
+    // Keccak padding, identical to keccak_Final()
+    for (unsigned int j = 0; j < lanes; j++) {
+        state[lanes * rest + j] ^= 0x01;
+        state[lanes * (KERL_RATE_WORDS - 1) + j] ^= UINT64_C(1) << 63;
+    }
+    permutation(state);
+}
+
+static void lanes_squeeze_final_chunk(uint64_t *state, unsigned int *rest,
+                                      unsigned int lanes,
+                                      unsigned char *bytes_out,
+                                      void (*permutation)(uint64_t *))
+{
+    lanes_pad_permute(state, *rest, lanes, permutation);
+
+    for (unsigned int j = 0; j < lanes; j++) {
+        unsigned char *bytes = bytes_out + j * CX_KECCAK384_SIZE;
+
+        for (unsigned int i = 0; i < KERL_CHUNK_WORDS; i++) {
+            os_memcpy(bytes + i * 8, &state[lanes * i + j], 8);
+        }
+        bytes_set_last_trit_zero(bytes);
+    }
+
+    os_memset(state, 0, 25 * lanes * sizeof(state[0]));
+    *rest = 0;
+}
+
+static void lanes_squeeze_chunk(uint64_t *state, unsigned int *rest,
+                                unsigned int lanes, unsigned char *bytes_out,
+                                void (*permutation)(uint64_t *))
+{
+    uint64_t chunks[KERL_CHUNK_WORDS * KERL_X8_LANES];
+
+    lanes_pad_permute(state, *rest, lanes, permutation);
+
+    for (unsigned int j = 0; j < lanes; j++) {
+        uint64_t *chunk = chunks + KERL_CHUNK_WORDS * j;
+        for (unsigned int i = 0; i < KERL_CHUNK_WORDS; i++) {
+            chunk[i] = state[lanes * i + j];
+        }
+    }
+    os_memcpy(bytes_out, chunks, lanes * CX_KECCAK384_SIZE);
+    for (unsigned int j = 0; j < lanes; j++) {
+        bytes_set_last_trit_zero(bytes_out + j * CX_KECCAK384_SIZE);
+    }
+
+    // reinitialize with the flipped state, identical to kerl_squeeze_chunk()
+    os_memset(state, 0, 25 * lanes * sizeof(state[0]));
+    for (unsigned int j = 0; j < lanes; j++) {
+        for (unsigned int i = 0; i < KERL_CHUNK_WORDS; i++) {
+            state[lanes * i + j] = ~chunks[KERL_CHUNK_WORDS * j + i];
+        }
+    }
+    *rest = KERL_CHUNK_WORDS;
+}
+
+static void lanes_chain(uint64_t *state, unsigned int lanes,
+                        unsigned char *bytes, const unsigned int *num,
+                        void (*permutation)(uint64_t *))
+{
+    uint64_t chunks[KERL_CHUNK_WORDS * KERL_X8_LANES];
+    unsigned int max_num = 0;
+
+    os_memcpy(chunks, bytes, lanes * CX_KECCAK384_SIZE);
+    for (unsigned int j = 0; j < lanes; j++) {
+        max_num = MAX(max_num, num[j]);
+    }
+
+    // lanes with shorter chains are still permuted, but their result ignored
+    for (unsigned int k = 0; k < max_num; k++) {
+        lanes_single_block(state, lanes, chunks);
+        permutation(state);
+
+        for (unsigned int j = 0; j < lanes; j++) {
+            if (k >= num[j]) {
+                continue;
+            }
+
+            uint64_t *chunk = chunks + KERL_CHUNK_WORDS * j;
+            for (unsigned int i = 0; i < KERL_CHUNK_WORDS; i++) {
+                chunk[i] = state[lanes * i + j];
+            }
+            bytes_set_last_trit_zero((unsigned char *)chunk);
+        }
+    }
+
+    os_memcpy(bytes, chunks, lanes * CX_KECCAK384_SIZE);
+}
+
+void kerl_initialize_x2(KERL_CTX_X2 *ctx)
+{
+    os_memset(ctx, 0, sizeof(KERL_CTX_X2));
+}
+
+void kerl_absorb_chunk_x2(KERL_CTX_X2 *ctx, const unsigned char *bytes)
+{
+    lanes_absorb_chunk(ctx->state, &ctx->rest, KERL_X2_LANES, bytes,
+                       dispatch->keccak_permutation_x2);
+}
+
+void kerl_squeeze_chunk_x2(KERL_CTX_X2 *ctx, unsigned char *bytes_out)
+{
+    lanes_squeeze_chunk(ctx->state, &ctx->rest, KERL_X2_LANES, bytes_out,
+                        dispatch->keccak_permutation_x2);
+}
+
+void kerl_squeeze_final_chunk_x2(KERL_CTX_X2 *ctx, unsigned char *bytes_out)
+{
+    lanes_squeeze_final_chunk(ctx->state, &ctx->rest, KERL_X2_LANES,
+                              bytes_out, dispatch->keccak_permutation_x2);
+}
+
+void kerl_chain_x2(unsigned char *bytes, const unsigned int *num)
+{
+    uint64_t state[sha3_max_permutation_size * KERL_X2_LANES];
+    lanes_chain(state, KERL_X2_LANES, bytes, num,
+                dispatch->keccak_permutation_x2);
+}
+
+void kerl_initialize_x4(KERL_CTX_X4 *ctx)
+{
+    os_memset(ctx, 0, sizeof(KERL_CTX_X4));
+}
+
+void kerl_absorb_chunk_x4(KERL_CTX_X4 *ctx, const unsigned char *bytes)
+{
+    lanes_absorb_chunk(ctx->state, &ctx->rest, KERL_X4_LANES, bytes,
+                       dispatch->keccak_permutation_x4);
+}
+
+void kerl_squeeze_chunk_x4(KERL_CTX_X4 *ctx, unsigned char *bytes_out)
+{
+    lanes_squeeze_chunk(ctx->state, &ctx->rest, KERL_X4_LANES, bytes_out,
+                        dispatch->keccak_permutation_x4);
+}
+
+void kerl_squeeze_final_chunk_x4(KERL_CTX_X4 *ctx, unsigned char *bytes_out)
+{
+    lanes_squeeze_final_chunk(ctx->state, &ctx->rest, KERL_X4_LANES,
+                              bytes_out, dispatch->keccak_permutation_x4);
+}
+
+void kerl_chain_x4(unsigned char *bytes, const unsigned int *num)
+{
+    uint64_t state[sha3_max_permutation_size * KERL_X4_LANES];
+    lanes_chain(state, KERL_X4_LANES, bytes, num,
+                dispatch->keccak_permutation_x4);
+}
+
+void kerl_initialize_x8(KERL_CTX_X8 *ctx)
+{
+    os_memset(ctx, 0, sizeof(KERL_CTX_X8));
+}
+
+void kerl_absorb_chunk_x8(KERL_CTX_X8 *ctx, const unsigned char *bytes)
+{
+    lanes_absorb_chunk(ctx->state, &ctx->rest, KERL_X8_LANES, bytes,
+                       dispatch->keccak_permutation_x8);
+}
+
+void kerl_squeeze_chunk_x8(KERL_CTX_X8 *ctx, unsigned char *bytes_out)
+{
+    lanes_squeeze_chunk(ctx->state, &ctx->rest, KERL_X8_LANES, bytes_out,
+                        dispatch->keccak_permutation_x8);
+}
+
+void kerl_squeeze_final_chunk_x8(KERL_CTX_X8 *ctx, unsigned char *bytes_out)
+{
+    lanes_squeeze_final_chunk(ctx->state, &ctx->rest, KERL_X8_LANES,
+                              bytes_out, dispatch->keccak_permutation_x8);
+}
+
+void kerl_chain_x8(unsigned char *bytes, const unsigned int *num)
+{
+    uint64_t state[sha3_max_permutation_size * KERL_X8_LANES];
+    lanes_chain(state, KERL_X8_LANES, bytes, num,
+                dispatch->keccak_permutation_x8);
+}
+
+/** @brief Computes the hash chains of up to KERL_X8_LANES chunks at once. */
+static void chain_group(unsigned char *bytes, unsigned int num_chunks,
+                        unsigned int n)
+{
+    unsigned int num[KERL_X8_LANES];
+    for (unsigned int j = 0; j < KERL_X8_LANES; j++) {
+        num[j] = j < num_chunks ? n : 0;
+    }
+
+    if (num_chunks == 1) {
+        kerl_chain(bytes, n);
+        return;
+    }
+    if (num_chunks == KERL_X2_LANES) {
+        kerl_chain_x2(bytes, num);
+        return;
+    }
+    if (num_chunks == KERL_X8_LANES) {
+        kerl_chain_x8(bytes, num);
+        return;
+    }
+
+    // the chunks are padded to the next lane count, the chains of the unused
+    // lanes are empty
+    unsigned char chunks[KERL_X8_LANES * CX_KECCAK384_SIZE] = {0};
+    os_memcpy(chunks, bytes, num_chunks * CX_KECCAK384_SIZE);
+
+    if (num_chunks <= KERL_X4_LANES) {
+        kerl_chain_x4(chunks, num);
+    }
+    else {
+        kerl_chain_x8(chunks, num);
+    }
+    os_memcpy(bytes, chunks, num_chunks * CX_KECCAK384_SIZE);
+}
+
+void kerl_chain_n(unsigned char *bytes, unsigned int num_chunks,
+                  unsigned int n)
+{
+    // use the lane count the current backend permutes most efficiently
+    const unsigned int lanes = dispatch->keccak_lanes;
+
+    for (unsigned int i = 0; i < num_chunks; i += lanes) {
+        chain_group(bytes + i * CX_KECCAK384_SIZE, MIN(num_chunks - i, lanes),
+                    n);
+    }
+}
@@ -7,60 +7,244 @@
 
 #include "common.h"
 
+/** @brief Context of a single Kerl instance.
+ *  Kerl always uses Keccak-384, so there is no need for a separate message
+ *  buffer; absorbed bytes are XORed directly into the state.
+ */
+typedef struct KERL_CTX {
+        // 1600-bit Keccak state
+        uint64_t state[25];
+        // number of bytes absorbed into the current block
+        unsigned int rest;
+} KERL_CTX;
+
 /** @brief Initializes the context for Kerl.
- *  @param sha3 the SHA context used.
+ *  @param ctx the Kerl context used
  */
-void kerl_initialize(cx_sha3_t *sha3);
+void kerl_initialize(KERL_CTX *ctx);
 
 /** @brief Reinitialize the context with the given Kerl state.
  *  A reinitialized context can then be used to squeeze further chunks.
- *  @param sha3 the SHA context used for hashing
+ *  @param ctx the Kerl context used
  *  @param state_bytes byte array containing the 48 byte Kerl state
  */
-void kerl_reinitialize(cx_sha3_t *sha3, const unsigned char *state_bytes);
+void kerl_reinitialize(KERL_CTX *ctx, const unsigned char *state_bytes);
 
 /** @brief Absorb exactly one chunk of 48 bytes.
- *  @param sha3 the SHA context used for hashing
+ *  @param ctx the Kerl context used
  *  @param bytes bytes to absorb.
  */
-void kerl_absorb_chunk(cx_sha3_t *sha3, const unsigned char* bytes);
+void kerl_absorb_chunk(KERL_CTX *ctx, const unsigned char* bytes);
 
 /** @brief Absorb arbitrary number of bytes.
- *  @param sha3 the SHA context used for hashing
+ *  @param ctx the Kerl context used
  *  @param bytes bytes to absorb.
  */
-void kerl_absorb_bytes(cx_sha3_t *sha3, const unsigned char* bytes, unsigned int len);
+void kerl_absorb_bytes(KERL_CTX *ctx, const unsigned char* bytes, unsigned int len);
 
 /** @brief Squeeze exactly one chunk of 48 bytes.
  *  This function automatically reinitializes kerl in the corresponding state.
- *  @param sha3 the SHA context used for hashing
+ *  @param ctx the Kerl context used
  *  @param bytes result byte array
  */
-void kerl_squeeze_chunk(cx_sha3_t *sha3, unsigned char* bytes);
+void kerl_squeeze_chunk(KERL_CTX *ctx, unsigned char* bytes);
 
 /** @brief Squeeze exactly one chunk of 48 bytes without reinitializing the
  *         hash context to allow for multiple squeeze.
  *  This funtion should be called, if no further squeeze are performed on this
  *  context, as it avoid unnecessary reinitializations.
- *  @param sha3 the SHA context used for hashing
+ *  @param ctx the Kerl context used
  *  @param bytes result byte array
  */
-void kerl_squeeze_final_chunk(cx_sha3_t *sha3, unsigned char *bytes_out);
+void kerl_squeeze_final_chunk(KERL_CTX *ctx, unsigned char *bytes_out);
 
 /** @brief Squeeze multiple chunks of 48 byte data.
- *  @param sha3 the SHA context used for hashing
+ *  @param ctx the Kerl context used
  *  @param bytes result byte array
  *  @param len number of bytes to squeeze.
  */
-void kerl_squeeze_bytes(cx_sha3_t *sha3, unsigned char* bytes, unsigned int len);
+void kerl_squeeze_bytes(KERL_CTX *ctx, unsigned char* bytes, unsigned int len);
 
 /** @brief Squeeze exactly one chunk of 48 bytes also returning the kerl state.
  *  The hash returned is identical to kerl_squeeze_chunk().
- *  The 48 byte kerl state can then be used in kerl_initialize_squeeze() to put any SHA context in the state.
- *  @param sha3 the SHA context used for hashing
+ *  The 48 byte kerl state can then be used in kerl_initialize_squeeze() to put any Kerl context in the state.
+ *  @param ctx the Kerl context used
  *  @param state_bytes target byte array to store the 48 byte state
  *  @param bytes result byte array
  */
-void kerl_state_squeeze_chunk(cx_sha3_t *sha3, unsigned char *state_bytes, unsigned char *bytes);
+void kerl_state_squeeze_chunk(KERL_CTX *ctx, unsigned char *state_bytes, unsigned char *bytes);
+
+/** @brief Computes the Kerl hash of exactly one chunk of 48 bytes.
+ *  This is identical to initializing, absorbing the chunk and squeezing the
+ *  final chunk, but without any context bookkeeping.
+ *  @param bytes chunk to hash
+ *  @param bytes_out result byte array, may be the same as bytes
+ */
+void kerl_hash_chunk(const unsigned char *bytes, unsigned char *bytes_out);
+
+/** @brief Hashes one chunk of 48 bytes n times in a row.
+ *  This is identical to calling kerl_hash_chunk(bytes, bytes) n times.
+ *  @param bytes chunk to hash, it is replaced by the result
+ *  @param n length of the hash chain
+ */
+void kerl_chain(unsigned char *bytes, unsigned int n);
+
+/** @brief Number of Kerl instances processed by the _x2 functions. */
+#define KERL_X2_LANES 2
+
+/** @brief Context of two independent Kerl instances hashed in parallel.
+ *  The layout is the same as in KERL_CTX_X4. The _x2 functions do not need
+ *  any SIMD instructions, they interleave the two instances in scalar code.
+ */
+typedef struct KERL_CTX_X2 {
+        // lane i of instance j is stored at state[KERL_X2_LANES * i + j]
+        uint64_t state[25 * KERL_X2_LANES];
+        // number of 64-bit words absorbed into the current block
+        unsigned int rest;
+} KERL_CTX_X2;
+
+/** @brief Initializes the context for two parallel Kerl instances.
+ *  @param ctx the multi-lane context used
+ */
+void kerl_initialize_x2(KERL_CTX_X2 *ctx);
+
+/** @brief Absorb exactly one chunk of 48 bytes in each of the instances.
+ *  @param ctx the multi-lane context used
+ *  @param bytes 2 consecutive 48-byte chunks, chunk j is absorbed by instance j
+ */
+void kerl_absorb_chunk_x2(KERL_CTX_X2 *ctx, const unsigned char *bytes);
+
+/** @brief Squeeze exactly one chunk of 48 bytes from each of the instances.
+ *  This is identical to kerl_squeeze_chunk() for each of the instances, so
+ *  that further chunks can be squeezed.
+ *  @param ctx the multi-lane context used
+ *  @param bytes_out 2 consecutive 48-byte chunks, chunk j is squeezed from
+ *         instance j
+ */
+void kerl_squeeze_chunk_x2(KERL_CTX_X2 *ctx, unsigned char *bytes_out);
+
+/** @brief Squeeze exactly one chunk of 48 bytes from each of the instances.
+ *  The context must be initialized again before it can be reused.
+ *  @param ctx the multi-lane context used
+ *  @param bytes_out 2 consecutive 48-byte chunks, chunk j is the hash of
+ *         instance j
+ */
+void kerl_squeeze_final_chunk_x2(KERL_CTX_X2 *ctx, unsigned char *bytes_out);
+
+/** @brief Computes two independent hash chains in parallel.
+ *  This is identical to calling kerl_chain() for each of the chunks.
+ *  @param bytes 2 consecutive 48-byte chunks, each is replaced by its result
+ *  @param num length of the hash chain for each of the chunks
+ */
+void kerl_chain_x2(unsigned char *bytes, const unsigned int *num);
+
+/** @brief Number of Kerl instances processed by the _x4 functions. */
+#define KERL_X4_LANES 4
+
+/** @brief Context of four independent Kerl instances hashed in parallel.
+ *  The Keccak states are interleaved lane by lane, so that they can be
+ *  permuted at once using SIMD instructions.
+ */
+typedef struct KERL_CTX_X4 {
+        // lane i of instance j is stored at state[KERL_X4_LANES * i + j]
+        uint64_t state[25 * KERL_X4_LANES];
+        // number of 64-bit words absorbed into the current block
+        unsigned int rest;
+} KERL_CTX_X4;
+
+/** @brief Initializes the context for four parallel Kerl instances.
+ *  @param ctx the multi-lane context used
+ */
+void kerl_initialize_x4(KERL_CTX_X4 *ctx);
+
+/** @brief Absorb exactly one chunk of 48 bytes in each of the instances.
+ *  @param ctx the multi-lane context used
+ *  @param bytes 4 consecutive 48-byte chunks, chunk j is absorbed by instance j
+ */
+void kerl_absorb_chunk_x4(KERL_CTX_X4 *ctx, const unsigned char *bytes);
+
+/** @brief Squeeze exactly one chunk of 48 bytes from each of the instances.
+ *  This is identical to kerl_squeeze_chunk() for each of the instances, so
+ *  that further chunks can be squeezed.
+ *  @param ctx the multi-lane context used
+ *  @param bytes_out 4 consecutive 48-byte chunks, chunk j is squeezed from
+ *         instance j
+ */
+void kerl_squeeze_chunk_x4(KERL_CTX_X4 *ctx, unsigned char *bytes_out);
+
+/** @brief Squeeze exactly one chunk of 48 bytes from each of the instances.
+ *  The context must be initialized again before it can be reused.
+ *  @param ctx the multi-lane context used
+ *  @param bytes_out 4 consecutive 48-byte chunks, chunk j is the hash of
+ *         instance j
+ */
+void kerl_squeeze_final_chunk_x4(KERL_CTX_X4 *ctx, unsigned char *bytes_out);
+
+/** @brief Computes four independent hash chains in parallel.
+ *  This is identical to calling kerl_chain() for each of the chunks.
+ *  @param bytes 4 consecutive 48-byte chunks, each is replaced by its result
+ *  @param num length of the hash chain for each of the chunks
+ */
+void kerl_chain_x4(unsigned char *bytes, const unsigned int *num);
+
+/** @brief Number of Kerl instances processed by the _x8 functions. */
+#define KERL_X8_LANES 8
+
+/** @brief Context of eight independent Kerl instances hashed in parallel.
+ *  The layout is the same as in KERL_CTX_X4.
+ */
+typedef struct KERL_CTX_X8 {
+        // lane i of instance j is stored at state[KERL_X8_LANES * i + j]
+        uint64_t state[25 * KERL_X8_LANES];
+        // number of 64-bit words absorbed into the current block
+        unsigned int rest;
+} KERL_CTX_X8;
+
+/** @brief Initializes the context for eight parallel Kerl instances.
+ *  @param ctx the multi-lane context used
+ */
+void kerl_initialize_x8(KERL_CTX_X8 *ctx);
+
+/** @brief Absorb exactly one chunk of 48 bytes in each of the instances.
+ *  @param ctx the multi-lane context used
+ *  @param bytes 8 consecutive 48-byte chunks, chunk j is absorbed by instance j
+ */
+void kerl_absorb_chunk_x8(KERL_CTX_X8 *ctx, const unsigned char *bytes);
+
+/** @brief Squeeze exactly one chunk of 48 bytes from each of the instances.
+ *  This is identical to kerl_squeeze_chunk() for each of the instances, so
+ *  that further chunks can be squeezed.
+ *  @param ctx the multi-lane context used
+ *  @param bytes_out 8 consecutive 48-byte chunks, chunk j is squeezed from
+ *         instance j
+ */
+void kerl_squeeze_chunk_x8(KERL_CTX_X8 *ctx, unsigned char *bytes_out);
+
+/** @brief Squeeze exactly one chunk of 48 bytes from each of the instances.
+ *  The context must be initialized again before it can be reused.
+ *  @param ctx the multi-lane context used
+ *  @param bytes_out 8 consecutive 48-byte chunks, chunk j is the hash of
+ *         instance j
+ */
+void kerl_squeeze_final_chunk_x8(KERL_CTX_X8 *ctx, unsigned char *bytes_out);
+
+/** @brief Computes eight independent hash chains in parallel.
+ *  This is identical to calling kerl_chain() for each of the chunks.
+ *  @param bytes 8 consecutive 48-byte chunks, each is replaced by its result
+ *  @param num length of the hash chain for each of the chunks
+ */
+void kerl_chain_x8(unsigned char *bytes, const unsigned int *num);
+
+/** @brief Computes hash chains of the same length for several chunks.
+ *  This is identical to calling kerl_chain() for each of the chunks, but the
+ *  chains are computed in parallel, using the multi-lane functions that are
+ *  most efficient on the current backend.
+ *  @param bytes num_chunks consecutive 48-byte chunks, each is replaced by its
+ *         result
+ *  @param num_chunks number of chunks
+ *  @param n length of the hash chain for each of the chunks
+ */
+void kerl_chain_n(unsigned char *bytes, unsigned int num_chunks,
+                  unsigned int n);
 
 #endif // KERL_H
@@ -9,10 +9,7 @@ static void initialize_state(const unsigned char *seed_bytes,
     os_memcpy(state, seed_bytes, 48);
     bytes_add_u32_mem(state, address_idx);
 
-    cx_sha3_t sha;
-    kerl_initialize(&sha);
-    kerl_absorb_chunk(&sha, state);
-    kerl_squeeze_final_chunk(&sha, state);
+    kerl_hash_chunk(state, state);
 }
 
 void signing_initialize(SIGNING_CTX *ctx, const unsigned char *seed_bytes,
@@ -31,7 +28,7 @@ static void generate_signature_fragment(unsigned char *state,
                                         const tryte_t *hash_fragment,
                                         unsigned char *signature_bytes)
 {
-    cx_sha3_t sha;
+    KERL_CTX sha;
     kerl_reinitialize(&sha, state);
 
     for (unsigned int j = 0; j < SIGNATURE_FRAGMENT_SIZE; j++) {
@@ -40,11 +37,7 @@ static void generate_signature_fragment(unsigned char *state,
         // the output of the squeeze is exactly the private key
         kerl_state_squeeze_chunk(&sha, state, signature_f);
 
-        for (unsigned int k = MAX_TRYTE_VALUE - hash_fragment[j]; k-- > 0;) {
-            kerl_initialize(&sha);
-            kerl_absorb_chunk(&sha, signature_f);
-            kerl_squeeze_final_chunk(&sha, signature_f);
-        }
+        kerl_chain(signature_f, MAX_TRYTE_VALUE - hash_fragment[j]);
 
         // if we are not the the final iteration reinitialize to get next key_f
         if (j < SIGNATURE_FRAGMENT_SIZE - 1) {
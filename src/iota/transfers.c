@@ -38,9 +38,11 @@ static const TX_OBJECT DEFAULT_TX = {
 
 static char *int64_to_chars(int64_t value, char *chars, unsigned int num_trytes)
 {
-    trit_t trits[num_trytes * 3];
-    int64_to_trits(value, trits, num_trytes * 3);
-    trits_to_chars(trits, chars, num_trytes * 3);
+    tryte_t trytes[27];
+    assert(num_trytes <= sizeof(trytes));
+
+    int64_to_trytes(value, trytes, num_trytes);
+    trytes_to_chars(trytes, chars, num_trytes);
 
     return chars + num_trytes;
 }
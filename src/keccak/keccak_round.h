@@ -0,0 +1,177 @@
+/** @file keccak_round.h
+ *  @brief Keccak-f[1600] round expressed in generic lane operations.
+ *
+ *  The lanes are held in 25 local variables named after their position,
+ *  e.g. Aba is lane (x=0, y=0) and Asu is lane (x=4, y=4) of the state A.
+ *  Before including this file the following must be defined:
+ *  KECCAK_LANE            type holding one lane (or one lane of several states)
+ *  KECCAK_XOR(a, b)       a ^ b
+ *  KECCAK_XOR5(a, ..., e) a ^ b ^ c ^ d ^ e
+ *  KECCAK_ROL(a, n)       rotate every 64-bit lane left by n, 0 < n < 64
+ *  KECCAK_CHI(a, b, c)    a ^ (~b & c)
+ *  KECCAK_XOR_RC(a, rc)   a ^ rc, where rc is a 64-bit round constant
+ */
+
+#ifndef KECCAK_ROUND_H
+#define KECCAK_ROUND_H
+
+#include <stdint.h>
+
+#define KECCAK_NUM_ROUNDS 24
+
+/* SHA3 (Keccak) constants for 24 rounds */
+static const uint64_t keccak_round_constants[KECCAK_NUM_ROUNDS] = {
+    UINT64_C(0x0000000000000001), UINT64_C(0x0000000000008082),
+    UINT64_C(0x800000000000808A), UINT64_C(0x8000000080008000),
+    UINT64_C(0x000000000000808B), UINT64_C(0x0000000080000001),
+    UINT64_C(0x8000000080008081), UINT64_C(0x8000000000008009),
+    UINT64_C(0x000000000000008A), UINT64_C(0x0000000000000088),
+    UINT64_C(0x0000000080008009), UINT64_C(0x000000008000000A),
+    UINT64_C(0x000000008000808B), UINT64_C(0x800000000000008B),
+    UINT64_C(0x8000000000008089), UINT64_C(0x8000000000008003),
+    UINT64_C(0x8000000000008002), UINT64_C(0x8000000000000080),
+    UINT64_C(0x000000000000800A), UINT64_C(0x800000008000000A),
+    UINT64_C(0x8000000080008081), UINT64_C(0x8000000000008080),
+    UINT64_C(0x0000000080000001), UINT64_C(0x8000000080008008)};
+
+/** @brief Declares the 25 lane variables of the state X. */
+#define KECCAK_DECLARE_LANES(X)                                                \
+    KECCAK_LANE X##ba, X##be, X##bi, X##bo, X##bu, X##ga, X##ge, X##gi,        \
+        X##go, X##gu, X##ka, X##ke, X##ki, X##ko, X##ku, X##ma, X##me,         \
+        X##mi, X##mo, X##mu, X##sa, X##se, X##si, X##so, X##su
+
+/** @brief Sets lane i of the state X to LOAD(i) for all 25 lanes. */
+#define KECCAK_LOAD_LANES(X, LOAD)                                             \
+    do {                                                                       \
+        X##ba = LOAD(0);                                                       \
+        X##be = LOAD(1);                                                       \
+        X##bi = LOAD(2);                                                       \
+        X##bo = LOAD(3);                                                       \
+        X##bu = LOAD(4);                                                       \
+        X##ga = LOAD(5);                                                       \
+        X##ge = LOAD(6);                                                       \
+        X##gi = LOAD(7);                                                       \
+        X##go = LOAD(8);                                                       \
+        X##gu = LOAD(9);                                                       \
+        X##ka = LOAD(10);                                                      \
+        X##ke = LOAD(11);                                                      \
+        X##ki = LOAD(12);                                                      \
+        X##ko = LOAD(13);                                                      \
+        X##ku = LOAD(14);                                                      \
+        X##ma = LOAD(15);                                                      \
+        X##me = LOAD(16);                                                      \
+        X##mi = LOAD(17);                                                      \
+        X##mo = LOAD(18);                                                      \
+        X##mu = LOAD(19);                                                      \
+        X##sa = LOAD(20);                                                      \
+        X##se = LOAD(21);                                                      \
+        X##si = LOAD(22);                                                      \
+        X##so = LOAD(23);                                                      \
+        X##su = LOAD(24);                                                      \
+    } while (0)
+
+/** @brief Calls STORE(i, lane) for all 25 lanes of the state X. */
+#define KECCAK_STORE_LANES(X, STORE)                                           \
+    do {                                                                       \
+        STORE(0, X##ba);                                                       \
+        STORE(1, X##be);                                                       \
+        STORE(2, X##bi);                                                       \
+        STORE(3, X##bo);                                                       \
+        STORE(4, X##bu);                                                       \
+        STORE(5, X##ga);                                                       \
+        STORE(6, X##ge);                                                       \
+        STORE(7, X##gi);                                                       \
+        STORE(8, X##go);                                                       \
+        STORE(9, X##gu);                                                       \
+        STORE(10, X##ka);                                                      \
+        STORE(11, X##ke);                                                      \
+        STORE(12, X##ki);                                                      \
+        STORE(13, X##ko);                                                      \
+        STORE(14, X##ku);                                                      \
+        STORE(15, X##ma);                                                      \
+        STORE(16, X##me);                                                      \
+        STORE(17, X##mi);                                                      \
+        STORE(18, X##mo);                                                      \
+        STORE(19, X##mu);                                                      \
+        STORE(20, X##sa);                                                      \
+        STORE(21, X##se);                                                      \
+        STORE(22, X##si);                                                      \
+        STORE(23, X##so);                                                      \
+        STORE(24, X##su);                                                      \
+    } while (0)
+
+/** @brief Computes one round on the state A and stores the result in E. */
+#define KECCAK_ROUND(A, E, rc)                                                 \
+    {                                                                          \
+        KECCAK_LANE Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du;                    \
+        KECCAK_LANE Ba, Be, Bi, Bo, Bu;                                        \
+                                                                               \
+        Ca = KECCAK_XOR5(A##ba, A##ga, A##ka, A##ma, A##sa);                   \
+        Ce = KECCAK_XOR5(A##be, A##ge, A##ke, A##me, A##se);                   \
+        Ci = KECCAK_XOR5(A##bi, A##gi, A##ki, A##mi, A##si);                   \
+        Co = KECCAK_XOR5(A##bo, A##go, A##ko, A##mo, A##so);                   \
+        Cu = KECCAK_XOR5(A##bu, A##gu, A##ku, A##mu, A##su);                   \
+        Da = KECCAK_XOR(Cu, KECCAK_ROL(Ce, 1));                                \
+        De = KECCAK_XOR(Ca, KECCAK_ROL(Ci, 1));                                \
+        Di = KECCAK_XOR(Ce, KECCAK_ROL(Co, 1));                                \
+        Do = KECCAK_XOR(Ci, KECCAK_ROL(Cu, 1));                                \
+        Du = KECCAK_XOR(Co, KECCAK_ROL(Ca, 1));                                \
+                                                                               \
+        Ba = KECCAK_XOR(A##ba, Da);                                            \
+        Be = KECCAK_ROL(KECCAK_XOR(A##ge, De), 44);                            \
+        Bi = KECCAK_ROL(KECCAK_XOR(A##ki, Di), 43);                            \
+        Bo = KECCAK_ROL(KECCAK_XOR(A##mo, Do), 21);                            \
+        Bu = KECCAK_ROL(KECCAK_XOR(A##su, Du), 14);                            \
+        E##ba = KECCAK_CHI(Ba, Be, Bi);                                        \
+        E##be = KECCAK_CHI(Be, Bi, Bo);                                        \
+        E##bi = KECCAK_CHI(Bi, Bo, Bu);                                        \
+        E##bo = KECCAK_CHI(Bo, Bu, Ba);                                        \
+        E##bu = KECCAK_CHI(Bu, Ba, Be);                                        \
+        E##ba = KECCAK_XOR_RC(E##ba, rc);                                      \
+                                                                               \
+        Ba = KECCAK_ROL(KECCAK_XOR(A##bo, Do), 28);                            \
+        Be = KECCAK_ROL(KECCAK_XOR(A##gu, Du), 20);                            \
+        Bi = KECCAK_ROL(KECCAK_XOR(A##ka, Da), 3);                             \
+        Bo = KECCAK_ROL(KECCAK_XOR(A##me, De), 45);                            \
+        Bu = KECCAK_ROL(KECCAK_XOR(A##si, Di), 61);                            \
+        E##ga = KECCAK_CHI(Ba, Be, Bi);                                        \
+        E##ge = KECCAK_CHI(Be, Bi, Bo);                                        \
+        E##gi = KECCAK_CHI(Bi, Bo, Bu);                                        \
+        E##go = KECCAK_CHI(Bo, Bu, Ba);                                        \
+        E##gu = KECCAK_CHI(Bu, Ba, Be);                                        \
+                                                                               \
+        Ba = KECCAK_ROL(KECCAK_XOR(A##be, De), 1);                             \
+        Be = KECCAK_ROL(KECCAK_XOR(A##gi, Di), 6);                             \
+        Bi = KECCAK_ROL(KECCAK_XOR(A##ko, Do), 25);                            \
+        Bo = KECCAK_ROL(KECCAK_XOR(A##mu, Du), 8);                             \
+        Bu = KECCAK_ROL(KECCAK_XOR(A##sa, Da), 18);                            \
+        E##ka = KECCAK_CHI(Ba, Be, Bi);                                        \
+        E##ke = KECCAK_CHI(Be, Bi, Bo);                                        \
+        E##ki = KECCAK_CHI(Bi, Bo, Bu);                                        \
+        E##ko = KECCAK_CHI(Bo, Bu, Ba);                                        \
+        E##ku = KECCAK_CHI(Bu, Ba, Be);                                        \
+                                                                               \
+        Ba = KECCAK_ROL(KECCAK_XOR(A##bu, Du), 27);                            \
+        Be = KECCAK_ROL(KECCAK_XOR(A##ga, Da), 36);                            \
+        Bi = KECCAK_ROL(KECCAK_XOR(A##ke, De), 10);                            \
+        Bo = KECCAK_ROL(KECCAK_XOR(A##mi, Di), 15);                            \
+        Bu = KECCAK_ROL(KECCAK_XOR(A##so, Do), 56);                            \
+        E##ma = KECCAK_CHI(Ba, Be, Bi);                                        \
+        E##me = KECCAK_CHI(Be, Bi, Bo);                                        \
+        E##mi = KECCAK_CHI(Bi, Bo, Bu);                                        \
+        E##mo = KECCAK_CHI(Bo, Bu, Ba);                                        \
+        E##mu = KECCAK_CHI(Bu, Ba, Be);                                        \
+                                                                               \
+        Ba = KECCAK_ROL(KECCAK_XOR(A##bi, Di), 62);                            \
+        Be = KECCAK_ROL(KECCAK_XOR(A##go, Do), 55);                            \
+        Bi = KECCAK_ROL(KECCAK_XOR(A##ku, Du), 39);                            \
+        Bo = KECCAK_ROL(KECCAK_XOR(A##ma, Da), 41);                            \
+        Bu = KECCAK_ROL(KECCAK_XOR(A##se, De), 2);                             \
+        E##sa = KECCAK_CHI(Ba, Be, Bi);                                        \
+        E##se = KECCAK_CHI(Be, Bi, Bo);                                        \
+        E##si = KECCAK_CHI(Bi, Bo, Bu);                                        \
+        E##so = KECCAK_CHI(Bo, Bu, Ba);                                        \
+        E##su = KECCAK_CHI(Bu, Ba, Be);                                        \
+    }
+
+#endif // KECCAK_ROUND_H
@@ -76,6 +76,17 @@
 #define USE_KECCAK 1
 #endif
 
+// use the fully unrolled Keccak-f[1600] permutation instead of the compact one
+#ifndef USE_KECCAK_UNROLLED
+#define USE_KECCAK_UNROLLED 1
+#endif
+
+// use the bit-interleaved Keccak-f[1600] permutation, which only needs 32-bit
+// operations and takes precedence over USE_KECCAK_UNROLLED
+#ifndef USE_KECCAK_INTERLEAVED32
+#define USE_KECCAK_INTERLEAVED32 0
+#endif
+
 // add way how to mark confidential data
 #ifndef CONFIDENTIAL
 #define CONFIDENTIAL
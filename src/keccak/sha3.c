@@ -21,6 +21,7 @@
 #include <string.h>
 
 #include "sha3.h"
+#include "keccak_round.h"
 #include "macros.h"
 
 #define I64(x) x##LL
@@ -29,19 +30,7 @@
 #define IS_ALIGNED_64(p) (0 == (7 & ((const char *)(p) - (const char *)0)))
 #define me64_to_le_str(to, from, length) memcpy((to), (from), (length))
 
-/* constants */
-#define NumberOfRounds 24
-
-/* SHA3 (Keccak) constants for 24 rounds */
-static uint64_t keccak_round_constants[NumberOfRounds] = {
-    I64(0x0000000000000001), I64(0x0000000000008082), I64(0x800000000000808A),
-    I64(0x8000000080008000), I64(0x000000000000808B), I64(0x0000000080000001),
-    I64(0x8000000080008081), I64(0x8000000000008009), I64(0x000000000000008A),
-    I64(0x0000000000000088), I64(0x0000000080008009), I64(0x000000008000000A),
-    I64(0x000000008000808B), I64(0x800000000000008B), I64(0x8000000000008089),
-    I64(0x8000000000008003), I64(0x8000000000008002), I64(0x8000000000000080),
-    I64(0x000000000000800A), I64(0x800000008000000A), I64(0x8000000080008081),
-    I64(0x8000000000008080), I64(0x0000000080000001), I64(0x8000000080008008)};
+#define NumberOfRounds KECCAK_NUM_ROUNDS
 
 /* Initializing a sha3 context for given number of output bits */
 static void keccak_Init(SHA3_CTX *ctx, unsigned bits)
@@ -164,7 +153,7 @@ static void keccak_chi(uint64_t *A)
     }
 }
 
-static void sha3_permutation(uint64_t *state)
+void sha3_permutation_compact(uint64_t *state)
 {
     int round;
     for (round = 0; round < NumberOfRounds; round++) {
@@ -204,6 +193,49 @@ static void sha3_permutation(uint64_t *state)
     }
 }
 
+void sha3_permutation(uint64_t *state)
+{
+#if USE_KECCAK_INTERLEAVED32
+    sha3_permutation_interleaved32(state);
+#elif USE_KECCAK_UNROLLED
+    sha3_permutation_unrolled(state);
+#else
+    sha3_permutation_compact(state);
+#endif
+}
+
+/**
+ * Permute several interleaved states one after the other.
+ *
+ * @param state the states, lane i of state j is stored at state[lanes * i + j]
+ * @param lanes the number of interleaved states
+ */
+static void sha3_permutation_lanes(uint64_t *state, unsigned lanes)
+{
+    uint64_t hash[sha3_max_permutation_size];
+    unsigned i, j;
+
+    for (j = 0; j < lanes; j++) {
+        for (i = 0; i < sha3_max_permutation_size; i++) {
+            hash[i] = state[lanes * i + j];
+        }
+        sha3_permutation(hash);
+        for (i = 0; i < sha3_max_permutation_size; i++) {
+            state[lanes * i + j] = hash[i];
+        }
+    }
+}
+
+void sha3_permutation_x4(uint64_t *state)
+{
+    sha3_permutation_lanes(state, 4);
+}
+
+void sha3_permutation_x8(uint64_t *state)
+{
+    sha3_permutation_lanes(state, 8);
+}
+
 /**
  * The core transformation. Process the specified block of data.
  *
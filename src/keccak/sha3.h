@@ -20,6 +20,7 @@
 #ifndef __SHA3_H__
 #define __SHA3_H__
 
+#include <stddef.h>
 #include <stdint.h>
 #include "options.h"
 
@@ -68,6 +69,30 @@ void sha3_512_Init(SHA3_CTX *ctx);
 void sha3_Update(SHA3_CTX *ctx, const unsigned char* msg, size_t size);
 void sha3_Final(SHA3_CTX *ctx, unsigned char* result);
 
+/* Keccak-f[1600] permutation implementations, the one used by the SHA3
+ * context is selected with USE_KECCAK_INTERLEAVED32 and USE_KECCAK_UNROLLED */
+
+void sha3_permutation(uint64_t *state);
+void sha3_permutation_compact(uint64_t *state);
+void sha3_permutation_unrolled(uint64_t *state);
+void sha3_permutation_interleaved32(uint64_t *state);
+
+/* permutations of several independent states at once, the lane i of the
+ * state j is stored at state[N * i + j] for N interleaved states */
+
+void sha3_permutation_x2(uint64_t *state);
+void sha3_permutation_x4(uint64_t *state);
+void sha3_permutation_x8(uint64_t *state);
+
+/* instruction set specific variants, which are only compiled if the
+ * corresponding instruction set is enabled for their source file */
+
+void sha3_permutation_unrolled_bmi2(uint64_t *state);
+void sha3_permutation_x2_bmi2(uint64_t *state);
+void sha3_permutation_x4_avx2(uint64_t *state);
+void sha3_permutation_x8_avx2(uint64_t *state);
+void sha3_permutation_x8_avx512(uint64_t *state);
+
 #if USE_KECCAK
 #define keccak_224_Init sha3_224_Init
 #define keccak_256_Init sha3_256_Init
@@ -0,0 +1,77 @@
+/** @file sha3_avx2.c
+ *  @brief Keccak-f[1600] permutation of four interleaved states using AVX2.
+ *
+ *  Each 256-bit register holds the same lane of four independent states, so
+ *  that one pass through the rounds permutes all four states at once. Eight
+ *  interleaved states are permuted in two passes.
+ */
+
+#include "sha3.h"
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+#define KECCAK_LANE __m256i
+#define KECCAK_XOR(a, b) _mm256_xor_si256(a, b)
+#define KECCAK_XOR5(a, b, c, d, e)                                             \
+    KECCAK_XOR(KECCAK_XOR(KECCAK_XOR(a, b), KECCAK_XOR(c, d)), e)
+#define KECCAK_ROL(a, n) rol_x4(a, n)
+#define KECCAK_CHI(a, b, c) _mm256_xor_si256(a, _mm256_andnot_si256(b, c))
+#define KECCAK_XOR_RC(a, rc) _mm256_xor_si256(a, _mm256_set1_epi64x(rc))
+
+#include "keccak_round.h"
+
+static inline __m256i rol_x4(__m256i a, int n)
+{
+    // rotations by whole bytes are a single shuffle
+    if (n == 8) {
+        return _mm256_shuffle_epi8(
+            a, _mm256_setr_epi8(7, 0, 1, 2, 3, 4, 5, 6, 15, 8, 9, 10, 11, 12,
+                                13, 14, 7, 0, 1, 2, 3, 4, 5, 6, 15, 8, 9, 10,
+                                11, 12, 13, 14));
+    }
+    if (n == 56) {
+        return _mm256_shuffle_epi8(
+            a, _mm256_setr_epi8(1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14,
+                                15, 8, 1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12,
+                                13, 14, 15, 8));
+    }
+    return _mm256_or_si256(_mm256_slli_epi64(a, n),
+                           _mm256_srli_epi64(a, 64 - n));
+}
+
+/* Permutes four interleaved states, which are stored in every stride-th group
+ * of four words, so that the same code also handles each half of eight
+ * interleaved states. */
+static inline void permutation_x4(uint64_t *state, unsigned int stride)
+{
+#define LOAD(i) _mm256_loadu_si256((const __m256i *)(state + stride * (i)))
+#define STORE(i, a) _mm256_storeu_si256((__m256i *)(state + stride * (i)), a)
+
+    KECCAK_DECLARE_LANES(A);
+    KECCAK_DECLARE_LANES(E);
+
+    KECCAK_LOAD_LANES(A, LOAD);
+    for (int round = 0; round < KECCAK_NUM_ROUNDS; round += 2) {
+        KECCAK_ROUND(A, E, keccak_round_constants[round]);
+        KECCAK_ROUND(E, A, keccak_round_constants[round + 1]);
+    }
+    KECCAK_STORE_LANES(A, STORE);
+
+#undef LOAD
+#undef STORE
+}
+
+void sha3_permutation_x4_avx2(uint64_t *state)
+{
+    permutation_x4(state, 4);
+}
+
+void sha3_permutation_x8_avx2(uint64_t *state)
+{
+    permutation_x4(state, 8);
+    permutation_x4(state + 4, 8);
+}
+
+#endif // __AVX2__
@@ -0,0 +1,47 @@
+/** @file sha3_avx512.c
+ *  @brief Keccak-f[1600] permutation of eight interleaved states using
+ *         AVX-512.
+ *
+ *  Each 512-bit register holds the same lane of eight independent states.
+ *  Rotations map to VPROLQ and both the theta parity and the chi step are a
+ *  single VPTERNLOGQ each.
+ */
+
+#include "sha3.h"
+
+#ifdef __AVX512F__
+
+#include <immintrin.h>
+
+// truth tables of a ^ b ^ c and a ^ (~b & c) for VPTERNLOGQ
+#define TERNLOG_XOR3 0x96
+#define TERNLOG_CHI 0xD2
+
+#define KECCAK_LANE __m512i
+#define KECCAK_XOR(a, b) _mm512_xor_si512(a, b)
+#define KECCAK_XOR5(a, b, c, d, e)                                             \
+    _mm512_ternarylogic_epi64(                                                 \
+        _mm512_ternarylogic_epi64(a, b, c, TERNLOG_XOR3), d, e, TERNLOG_XOR3)
+#define KECCAK_ROL(a, n) _mm512_rol_epi64(a, n)
+#define KECCAK_CHI(a, b, c) _mm512_ternarylogic_epi64(a, b, c, TERNLOG_CHI)
+#define KECCAK_XOR_RC(a, rc) _mm512_xor_si512(a, _mm512_set1_epi64(rc))
+
+#include "keccak_round.h"
+
+#define LOAD(i) _mm512_loadu_si512((const void *)(state + 8 * (i)))
+#define STORE(i, a) _mm512_storeu_si512((void *)(state + 8 * (i)), a)
+
+void sha3_permutation_x8_avx512(uint64_t *state)
+{
+    KECCAK_DECLARE_LANES(A);
+    KECCAK_DECLARE_LANES(E);
+
+    KECCAK_LOAD_LANES(A, LOAD);
+    for (int round = 0; round < KECCAK_NUM_ROUNDS; round += 2) {
+        KECCAK_ROUND(A, E, keccak_round_constants[round]);
+        KECCAK_ROUND(E, A, keccak_round_constants[round + 1]);
+    }
+    KECCAK_STORE_LANES(A, STORE);
+}
+
+#endif // __AVX512F__
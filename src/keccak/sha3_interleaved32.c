@@ -0,0 +1,130 @@
+/** @file sha3_interleaved32.c
+ *  @brief Keccak-f[1600] permutation using only 32-bit operations.
+ *
+ *  Each 64-bit lane is split into two 32-bit words holding its even and its
+ *  odd bits (bit interleaving). A 64-bit rotation then becomes two 32-bit
+ *  rotations, which is a single instruction each on 32-bit cores, instead of
+ *  a sequence of shifts and ORs across both halves of the lane. The state is
+ *  converted into the interleaved form and back at the permutation
+ *  boundaries, so the interface is the same as for the other permutations.
+ */
+
+#include "sha3.h"
+
+typedef struct {
+    uint32_t even, odd;
+} lane_il;
+
+#define ROTL32(word, n) ((word) << (n) | (word) >> ((32 - (n)) & 31))
+
+// the round constants in interleaved form
+static const lane_il round_constants_il[24] = {
+    {0x00000001, 0x00000000}, {0x00000000, 0x00000089},
+    {0x00000000, 0x8000008b}, {0x00000000, 0x80008080},
+    {0x00000001, 0x0000008b}, {0x00000001, 0x00008000},
+    {0x00000001, 0x80008088}, {0x00000001, 0x80000082},
+    {0x00000000, 0x0000000b}, {0x00000000, 0x0000000a},
+    {0x00000001, 0x00008082}, {0x00000000, 0x00008003},
+    {0x00000001, 0x0000808b}, {0x00000001, 0x8000000b},
+    {0x00000001, 0x8000008a}, {0x00000001, 0x80000081},
+    {0x00000000, 0x80000081}, {0x00000000, 0x80000008},
+    {0x00000000, 0x00000083}, {0x00000000, 0x80008003},
+    {0x00000001, 0x80008088}, {0x00000000, 0x80000088},
+    {0x00000001, 0x00008000}, {0x00000000, 0x80008082}};
+
+static inline lane_il xor_il(lane_il a, lane_il b)
+{
+    const lane_il r = {a.even ^ b.even, a.odd ^ b.odd};
+    return r;
+}
+
+/* Rotating by an even amount rotates both halves by half of it. For an odd
+ * amount the even bits move to odd positions and vice versa. The amount is
+ * always a constant, so the branch is resolved at compile time. */
+static inline lane_il rol_il(lane_il a, int n)
+{
+    if (n % 2 == 0) {
+        const lane_il r = {ROTL32(a.even, n / 2), ROTL32(a.odd, n / 2)};
+        return r;
+    }
+    const lane_il r = {ROTL32(a.odd, (n + 1) / 2), ROTL32(a.even, n / 2)};
+    return r;
+}
+
+static inline lane_il chi_il(lane_il a, lane_il b, lane_il c)
+{
+    const lane_il r = {a.even ^ (~b.even & c.even), a.odd ^ (~b.odd & c.odd)};
+    return r;
+}
+
+/* KECCAK_ROUND is given the round index instead of the round constant */
+#define KECCAK_LANE lane_il
+#define KECCAK_XOR(a, b) xor_il(a, b)
+#define KECCAK_XOR5(a, b, c, d, e)                                             \
+    xor_il(xor_il(xor_il(a, b), xor_il(c, d)), e)
+#define KECCAK_ROL(a, n) rol_il(a, n)
+#define KECCAK_CHI(a, b, c) chi_il(a, b, c)
+#define KECCAK_XOR_RC(a, round) xor_il(a, round_constants_il[round])
+
+#include "keccak_round.h"
+
+/* Swaps the bits of x selected by mask with the ones shift positions higher */
+#define DELTA_SWAP(x, mask, shift)                                             \
+    do {                                                                       \
+        const uint32_t t = ((x) ^ ((x) >> (shift))) & (mask);                  \
+        (x) ^= t ^ (t << (shift));                                             \
+    } while (0)
+
+/* Moves the even bits into the lower and the odd bits into the upper half */
+static inline uint32_t unshuffle(uint32_t x)
+{
+    DELTA_SWAP(x, 0x22222222, 1);
+    DELTA_SWAP(x, 0x0C0C0C0C, 2);
+    DELTA_SWAP(x, 0x00F000F0, 4);
+    DELTA_SWAP(x, 0x0000FF00, 8);
+    return x;
+}
+
+/* The inverse of unshuffle() */
+static inline uint32_t shuffle(uint32_t x)
+{
+    DELTA_SWAP(x, 0x0000FF00, 8);
+    DELTA_SWAP(x, 0x00F000F0, 4);
+    DELTA_SWAP(x, 0x0C0C0C0C, 2);
+    DELTA_SWAP(x, 0x22222222, 1);
+    return x;
+}
+
+static inline lane_il to_interleaved(uint64_t lane)
+{
+    const uint32_t low = unshuffle((uint32_t)lane);
+    const uint32_t high = unshuffle((uint32_t)(lane >> 32));
+
+    const lane_il r = {(low & 0x0000FFFF) | (high << 16),
+                       (low >> 16) | (high & 0xFFFF0000)};
+    return r;
+}
+
+static inline uint64_t from_interleaved(lane_il a)
+{
+    const uint32_t low = shuffle((a.even & 0x0000FFFF) | (a.odd << 16));
+    const uint32_t high = shuffle((a.even >> 16) | (a.odd & 0xFFFF0000));
+
+    return (uint64_t)high << 32 | low;
+}
+
+#define LOAD(i) to_interleaved(state[i])
+#define STORE(i, a) state[i] = from_interleaved(a)
+
+void sha3_permutation_interleaved32(uint64_t *state)
+{
+    KECCAK_DECLARE_LANES(A);
+    KECCAK_DECLARE_LANES(E);
+
+    KECCAK_LOAD_LANES(A, LOAD);
+    for (int round = 0; round < KECCAK_NUM_ROUNDS; round += 2) {
+        KECCAK_ROUND(A, E, round);
+        KECCAK_ROUND(E, A, round + 1);
+    }
+    KECCAK_STORE_LANES(A, STORE);
+}
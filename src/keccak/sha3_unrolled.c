@@ -0,0 +1,154 @@
+/** @file sha3_unrolled.c
+ *  @brief Fully unrolled scalar Keccak-f[1600] permutation.
+ *
+ *  The state is kept in 25 local variables for all 24 rounds, so that it can
+ *  stay in registers. Rho and pi are merged into the lane loads of chi, and
+ *  two rounds are computed per loop iteration by alternating between the
+ *  states A and E. Six lanes are kept complemented during the permutation
+ *  (lane complementing transform), which removes most of the NOT operations
+ *  in chi on cores without an and-not instruction.
+ *
+ *  sha3_permutation_x2() permutes two interleaved states in the same way.
+ */
+
+#include "sha3.h"
+
+#define KECCAK_LANE uint64_t
+#include "keccak_round.h"
+
+// sha3_unrolled_bmi2.c compiles this file again with suffixed names
+#ifndef SHA3_UNROLLED
+#define SHA3_UNROLLED(name) name
+#endif
+
+#define ROTL64(qword, n) ((qword) << (n) ^ ((qword) >> (64 - (n))))
+
+/* One round on the state A with the lanes 1, 2, 8, 12, 17 and 20 complemented,
+ * the result is stored in E with the same lanes complemented. */
+#define KECCAK_ROUND_COMPLEMENTED(A, E, rc)                                    \
+    {                                                                          \
+        uint64_t Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du;                       \
+        uint64_t Ba, Be, Bi, Bo, Bu;                                           \
+                                                                               \
+        Ca = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa;                            \
+        Ce = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se;                            \
+        Ci = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si;                            \
+        Co = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so;                            \
+        Cu = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su;                            \
+        Da = Cu ^ ROTL64(Ce, 1);                                               \
+        De = Ca ^ ROTL64(Ci, 1);                                               \
+        Di = Ce ^ ROTL64(Co, 1);                                               \
+        Do = Ci ^ ROTL64(Cu, 1);                                               \
+        Du = Co ^ ROTL64(Ca, 1);                                               \
+                                                                               \
+        Ba = A##ba ^ Da;                                                       \
+        Be = ROTL64(A##ge ^ De, 44);                                           \
+        Bi = ROTL64(A##ki ^ Di, 43);                                           \
+        Bo = ROTL64(A##mo ^ Do, 21);                                           \
+        Bu = ROTL64(A##su ^ Du, 14);                                           \
+        E##ba = Ba ^ (Be | Bi);                                                \
+        E##be = Be ^ (~Bi | Bo);                                               \
+        E##bi = Bi ^ (Bo & Bu);                                                \
+        E##bo = Bo ^ (Bu | Ba);                                                \
+        E##bu = Bu ^ (Ba & Be);                                                \
+        E##ba ^= rc;                                                           \
+                                                                               \
+        Ba = ROTL64(A##bo ^ Do, 28);                                           \
+        Be = ROTL64(A##gu ^ Du, 20);                                           \
+        Bi = ROTL64(A##ka ^ Da, 3);                                            \
+        Bo = ROTL64(A##me ^ De, 45);                                           \
+        Bu = ROTL64(A##si ^ Di, 61);                                           \
+        E##ga = Ba ^ (Be | Bi);                                                \
+        E##ge = Be ^ (Bi & Bo);                                                \
+        E##gi = Bi ^ (Bo | ~Bu);                                               \
+        E##go = Bo ^ (Bu | Ba);                                                \
+        E##gu = Bu ^ (Ba & Be);                                                \
+                                                                               \
+        Ba = ROTL64(A##be ^ De, 1);                                            \
+        Be = ROTL64(A##gi ^ Di, 6);                                            \
+        Bi = ROTL64(A##ko ^ Do, 25);                                           \
+        Bo = ROTL64(A##mu ^ Du, 8);                                            \
+        Bu = ROTL64(A##sa ^ Da, 18);                                           \
+        E##ka = Ba ^ (Be | Bi);                                                \
+        E##ke = Be ^ (Bi & Bo);                                                \
+        E##ki = Bi ^ (~Bo & Bu);                                               \
+        E##ko = Bo ^ (~Bu & ~Ba);                                              \
+        E##ku = Bu ^ (Ba & Be);                                                \
+                                                                               \
+        Ba = ROTL64(A##bu ^ Du, 27);                                           \
+        Be = ROTL64(A##ga ^ Da, 36);                                           \
+        Bi = ROTL64(A##ke ^ De, 10);                                           \
+        Bo = ROTL64(A##mi ^ Di, 15);                                           \
+        Bu = ROTL64(A##so ^ Do, 56);                                           \
+        E##ma = Ba ^ (Be & Bi);                                                \
+        E##me = Be ^ (Bi | Bo);                                                \
+        E##mi = Bi ^ (~Bo | Bu);                                               \
+        E##mo = Bo ^ (~Bu | ~Ba);                                              \
+        E##mu = Bu ^ (Ba | Be);                                                \
+                                                                               \
+        Ba = ROTL64(A##bi ^ Di, 62);                                           \
+        Be = ROTL64(A##go ^ Do, 55);                                           \
+        Bi = ROTL64(A##ku ^ Du, 39);                                           \
+        Bo = ROTL64(A##ma ^ Da, 41);                                           \
+        Bu = ROTL64(A##se ^ De, 2);                                            \
+        E##sa = Ba ^ (~Be & Bi);                                               \
+        E##se = Be ^ (~Bi & ~Bo);                                              \
+        E##si = Bi ^ (Bo & Bu);                                                \
+        E##so = Bo ^ (Bu | Ba);                                                \
+        E##su = Bu ^ (Ba & Be);                                                \
+    }
+
+
+// bit i is set for the complemented lanes 1, 2, 8, 12, 17 and 20
+#define COMPLEMENTED_LANES 0x121106
+#define COMPLEMENT(i, x) (((COMPLEMENTED_LANES >> (i)) & 1) ? ~(x) : (x))
+
+void SHA3_UNROLLED(sha3_permutation_unrolled)(uint64_t *state)
+{
+#define LOAD(i) COMPLEMENT(i, state[i])
+#define STORE(i, a) state[i] = COMPLEMENT(i, a)
+
+    KECCAK_DECLARE_LANES(A);
+    KECCAK_DECLARE_LANES(E);
+
+    KECCAK_LOAD_LANES(A, LOAD);
+    for (int round = 0; round < KECCAK_NUM_ROUNDS; round += 2) {
+        KECCAK_ROUND_COMPLEMENTED(A, E, keccak_round_constants[round]);
+        KECCAK_ROUND_COMPLEMENTED(E, A, keccak_round_constants[round + 1]);
+    }
+    KECCAK_STORE_LANES(A, STORE);
+
+#undef LOAD
+#undef STORE
+}
+
+/* The rounds of both states are issued alternately. As they are independent,
+ * an out-of-order core can overlap them without any SIMD units. */
+void SHA3_UNROLLED(sha3_permutation_x2)(uint64_t *state)
+{
+#define LOAD0(i) COMPLEMENT(i, state[2 * (i)])
+#define LOAD1(i) COMPLEMENT(i, state[2 * (i) + 1])
+#define STORE0(i, a) state[2 * (i)] = COMPLEMENT(i, a)
+#define STORE1(i, a) state[2 * (i) + 1] = COMPLEMENT(i, a)
+
+    KECCAK_DECLARE_LANES(A0);
+    KECCAK_DECLARE_LANES(E0);
+    KECCAK_DECLARE_LANES(A1);
+    KECCAK_DECLARE_LANES(E1);
+
+    KECCAK_LOAD_LANES(A0, LOAD0);
+    KECCAK_LOAD_LANES(A1, LOAD1);
+    for (int round = 0; round < KECCAK_NUM_ROUNDS; round += 2) {
+        KECCAK_ROUND_COMPLEMENTED(A0, E0, keccak_round_constants[round]);
+        KECCAK_ROUND_COMPLEMENTED(A1, E1, keccak_round_constants[round]);
+        KECCAK_ROUND_COMPLEMENTED(E0, A0, keccak_round_constants[round + 1]);
+        KECCAK_ROUND_COMPLEMENTED(E1, A1, keccak_round_constants[round + 1]);
+    }
+    KECCAK_STORE_LANES(A0, STORE0);
+    KECCAK_STORE_LANES(A1, STORE1);
+
+#undef LOAD0
+#undef LOAD1
+#undef STORE0
+#undef STORE1
+}
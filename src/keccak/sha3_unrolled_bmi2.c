@@ -0,0 +1,16 @@
+/** @file sha3_unrolled_bmi2.c
+ *  @brief Fully unrolled scalar Keccak-f[1600] permutations for BMI2.
+ *
+ *  The same code as in sha3_unrolled.c, but compiled with BMI1 and BMI2
+ *  enabled, so that rotations use the non-destructive rorx instruction and
+ *  chi uses andn.
+ */
+
+#include "sha3.h"
+
+#if defined(__BMI__) && defined(__BMI2__)
+
+#define SHA3_UNROLLED(name) name##_bmi2
+#include "sha3_unrolled.c"
+
+#endif // __BMI__ && __BMI2__
@@ -6,48 +6,98 @@
 #include "iota/kerl.h"
 #include "iota/conversion.h"
 #include "iota/addresses.h"
+#include "iota/address_engine.h"
+
+// number of addresses computed at once by the single-threaded path
+#define PRINT_BATCH 64
 
 int print_help();
-void address(char* seedChars, int index, int security, char* result);
+int print_addresses(unsigned char *seed_bytes, int index, int count,
+                    int security, int threads);
 
 int main(int argc, char *argv[]){
 
-	if (argc != 5) {
+	if (argc != 5 && argc != 6) {
 		return print_help();
 	}
 
-	int num;
 	int security = (int)strtol(argv[2], NULL, 10);
 	int index = (int)strtol(argv[3], NULL, 10);
 	int count = (int)strtol(argv[4], NULL, 10);
 	char* seed_chars = argv[1];
 
-	char addresses[(count*82)];
-	addresses[0] = '\0';
-	for (int i = 0; i < count; i++) {
-		char char_address[81];
-		address(seed_chars, index+i, security, char_address);
-		strcat(addresses, char_address);
-		strcat(addresses, "\n");
+	int threads = 1;
+	if (argc == 6) {
+		char *end;
+		const long value = strtol(argv[5], &end, 10);
+		if (end == argv[5] || *end != '\0' || value < 1 ||
+		    value > ADDRESS_ENGINE_MAX_THREADS) {
+			fprintf(stderr, "invalid THREADS \"%s\", must be 1 to %d\n",
+			        argv[5], ADDRESS_ENGINE_MAX_THREADS);
+			return 1;
+		}
+		threads = (int)value;
+	}
+
+	// checked here, so that all thread counts report it in the same way
+	if (security < MIN_SECURITY_LEVEL || security > MAX_SECURITY_LEVEL) {
+		fprintf(stderr, "invalid SECURITY %d, must be %d to %d\n", security,
+		        MIN_SECURITY_LEVEL, MAX_SECURITY_LEVEL);
+		return 1;
+	}
+
+	if (count <= 0) {
+		return 0;
+	}
+
+	unsigned char seed_bytes[48];
+	chars_to_bytes(seed_chars, seed_bytes, 81);
+
+	if (threads > 1) {
+		return print_addresses(seed_bytes, index, count, security, threads);
 	}
 
+	// compute the addresses in batches, so that each one is printed soon
+	unsigned char addresses[PRINT_BATCH * 48];
+	for (int i = 0; i < count; i += PRINT_BATCH) {
+		const int n = count - i < PRINT_BATCH ? count - i : PRINT_BATCH;
+		get_public_addrs(seed_bytes, index + i, n, security, addresses);
+
+		for (int j = 0; j < n; j++) {
+			char char_address[82];
+			bytes_to_chars(addresses + j * 48, char_address, 48);
+			char_address[81] = '\0';
+			printf("%s\n", char_address);
+		}
+	}
 
-	printf("%s", addresses);
-	
 	return 0;
 }
 
 int print_help() {
-	printf("Usage c_light_wallet <SEED_81_CHARS> SECURITY INDEX COUNT\n");
+	printf("Usage c_light_wallet <SEED_81_CHARS> SECURITY INDEX COUNT [THREADS]\n");
 	return 0;
 }
 
-void address(char* seed_chars, int index, int security, char result[81]) {
-	
-	unsigned char address[81];
-	unsigned char seed_bytes[48];
-	chars_to_bytes(seed_chars, seed_bytes, 81);
-	get_public_addr(seed_bytes, index, security, address);
-	
-	bytes_to_chars(address, result, 48);
+// prints the addresses as they are generated by several threads
+int print_addresses(unsigned char *seed_bytes, int index, int count,
+                    int security, int threads) {
+
+	static ADDRESS_ENGINE engine;
+	if (address_engine_start(&engine, seed_bytes, index, count, security,
+	                         threads) != 0) {
+		fprintf(stderr, "could not start %d threads\n", threads);
+		return 1;
+	}
+
+	unsigned char address[48];
+	while (address_engine_next(&engine, address)) {
+		char char_address[82];
+		bytes_to_chars(address, char_address, 48);
+		char_address[81] = '\0';
+		printf("%s\n", char_address);
+	}
+
+	address_engine_stop(&engine);
+	return 0;
 }
@@ -3,6 +3,7 @@
 #include "test_vectors.h"
 #include "hash_file.h"
 #include "iota/addresses.h"
+#include "iota/address_engine.h"
 #include "iota/conversion.h"
 
 static void seed_address(const char *seed_chars, uint32_t idx, uint8_t security,
@@ -86,6 +87,170 @@ static void test_n_addresses_for_seed(void **state)
     test_for_each_line("generateNAddressesForSeed", test);
 }
 
+static void test_address_range(const TEST_VECTOR *vector, uint8_t security)
+{
+    unsigned char seed_bytes[NUM_HASH_BYTES];
+    chars_to_bytes(vector->seed, seed_bytes, NUM_HASH_TRYTES);
+
+    // all ranges of the test vector, so that every index is at every
+    // position of a batch
+    for (uint32_t start = 0; start <= MAX_ADDRESS_INDEX; start++) {
+        const unsigned int count = MAX_ADDRESS_INDEX + 1 - start;
+
+        unsigned char
+            addresses_bytes[(MAX_ADDRESS_INDEX + 1) * NUM_HASH_BYTES];
+        get_public_addrs(seed_bytes, start, count, security, addresses_bytes);
+
+        for (unsigned int i = 0; i < count; i++) {
+            char output[NUM_HASH_TRYTES + 1];
+            bytes_to_chars(addresses_bytes + i * NUM_HASH_BYTES, output,
+                           NUM_HASH_BYTES);
+            output[NUM_HASH_TRYTES] = '\0';
+
+            assert_string_equal(output,
+                                vector->addresses[security][start + i]);
+        }
+    }
+}
+
+static void test_address_ranges(void **state)
+{
+    (void)state; // unused
+
+    for (uint8_t security = 1; security <= 3; security++) {
+        test_address_range(&PETER_VECTOR, security);
+        test_address_range(&OVERFLOW_VECTOR, security);
+    }
+}
+
+static void test_address_all_levels(const TEST_VECTOR *vector)
+{
+    unsigned char seed_bytes[NUM_HASH_BYTES];
+    chars_to_bytes(vector->seed, seed_bytes, NUM_HASH_TRYTES);
+
+    for (uint32_t idx = 0; idx <= MAX_ADDRESS_INDEX; idx++) {
+        unsigned char addresses_bytes[MAX_SECURITY_LEVEL * NUM_HASH_BYTES];
+        get_public_addr_all_levels(seed_bytes, idx, addresses_bytes);
+
+        for (uint8_t security = 1; security <= MAX_SECURITY_LEVEL;
+             security++) {
+            char output[NUM_HASH_TRYTES + 1];
+            bytes_to_chars(addresses_bytes + (security - 1) * NUM_HASH_BYTES,
+                           output, NUM_HASH_BYTES);
+            output[NUM_HASH_TRYTES] = '\0';
+
+            assert_string_equal(output, vector->addresses[security][idx]);
+        }
+    }
+}
+
+static void test_addresses_all_levels(void **state)
+{
+    (void)state; // unused
+
+    test_address_all_levels(&PETER_VECTOR);
+    test_address_all_levels(&OVERFLOW_VECTOR);
+}
+
+static void test_address_range_batches(void **state)
+{
+    (void)state; // unused
+
+    // several full batches of addresses computed in lockstep and a partial one
+    const unsigned int count = 19;
+
+    unsigned char seed_bytes[NUM_HASH_BYTES];
+    chars_to_bytes(OVERFLOW_VECTOR.seed, seed_bytes, NUM_HASH_TRYTES);
+
+    for (unsigned int security = 1; security <= 3; security++) {
+        unsigned char addresses_bytes[19 * NUM_HASH_BYTES];
+        get_public_addrs(seed_bytes, 1000, count, security, addresses_bytes);
+
+        for (unsigned int i = 0; i < count; i++) {
+            unsigned char expected[NUM_HASH_BYTES];
+            get_public_addr(seed_bytes, 1000 + i, security, expected);
+            assert_memory_equal(addresses_bytes + i * NUM_HASH_BYTES,
+                                expected, NUM_HASH_BYTES);
+        }
+    }
+}
+
+static void test_address_range_wrap(void **state)
+{
+    (void)state; // unused
+
+    unsigned char seed_bytes[NUM_HASH_BYTES];
+    chars_to_bytes(PETER_VECTOR.seed, seed_bytes, NUM_HASH_TRYTES);
+
+    // the index wraps around after UINT32_MAX just as in get_public_addr()
+    unsigned char addresses_bytes[2 * NUM_HASH_BYTES];
+    get_public_addrs(seed_bytes, UINT32_MAX, 2, 1, addresses_bytes);
+
+    unsigned char expected[NUM_HASH_BYTES];
+    get_public_addr(seed_bytes, UINT32_MAX, 1, expected);
+    assert_memory_equal(addresses_bytes, expected, NUM_HASH_BYTES);
+    get_public_addr(seed_bytes, 0, 1, expected);
+    assert_memory_equal(addresses_bytes + NUM_HASH_BYTES, expected,
+                        NUM_HASH_BYTES);
+}
+
+static void check_address_engine(unsigned int num_threads)
+{
+    // more addresses than fit into the ring
+    const unsigned int count = ADDRESS_ENGINE_RING_SIZE + 37;
+
+    unsigned char seed_bytes[NUM_HASH_BYTES];
+    chars_to_bytes(PETER_VECTOR.seed, seed_bytes, NUM_HASH_TRYTES);
+
+    unsigned char expected[(ADDRESS_ENGINE_RING_SIZE + 37) * NUM_HASH_BYTES];
+    get_public_addrs(seed_bytes, 5, count, 1, expected);
+
+    static ADDRESS_ENGINE engine;
+    assert_int_equal(
+        address_engine_start(&engine, seed_bytes, 5, count, 1, num_threads),
+        0);
+
+    for (unsigned int i = 0; i < count; i++) {
+        unsigned char address_bytes[NUM_HASH_BYTES];
+        assert_true(address_engine_next(&engine, address_bytes));
+        assert_memory_equal(address_bytes, expected + i * NUM_HASH_BYTES,
+                            NUM_HASH_BYTES);
+    }
+    unsigned char address_bytes[NUM_HASH_BYTES];
+    assert_false(address_engine_next(&engine, address_bytes));
+
+    address_engine_stop(&engine);
+}
+
+static void test_address_engine(void **state)
+{
+    (void)state; // unused
+
+    check_address_engine(1);
+    check_address_engine(3);
+    check_address_engine(ADDRESS_ENGINE_MAX_THREADS);
+}
+
+static void test_address_engine_early_stop(void **state)
+{
+    (void)state; // unused
+
+    unsigned char seed_bytes[NUM_HASH_BYTES];
+    chars_to_bytes(PETER_VECTOR.seed, seed_bytes, NUM_HASH_TRYTES);
+
+    static ADDRESS_ENGINE engine;
+    assert_int_equal(address_engine_start(&engine, seed_bytes, 0, 100000, 1, 4),
+                     0);
+
+    unsigned char address_bytes[NUM_HASH_BYTES];
+    assert_true(address_engine_next(&engine, address_bytes));
+    address_engine_stop(&engine);
+
+    // invalid parameters
+    assert_int_equal(address_engine_start(&engine, seed_bytes, 0, 1, 4, 1), -1);
+    assert_int_equal(address_engine_start(&engine, seed_bytes, 0, 1, 1, 0), -1);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -124,6 +289,12 @@ int main(void)
                                   (uint32_t *)3),
         cmocka_unit_test_prestate(test_overflow_seed_level_three,
                                   (uint32_t *)4),
+        cmocka_unit_test(test_address_ranges),
+        cmocka_unit_test(test_address_range_batches),
+        cmocka_unit_test(test_addresses_all_levels),
+        cmocka_unit_test(test_address_range_wrap),
+        cmocka_unit_test(test_address_engine),
+        cmocka_unit_test(test_address_engine_early_stop),
         cmocka_unit_test(test_n_addresses_for_seed)};
 
     return cmocka_run_group_tests(tests, NULL, NULL);
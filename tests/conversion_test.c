@@ -2,6 +2,7 @@
 #include <stdlib.h>
 // include the c-file to be able to test static functions
 #include "iota/conversion.c"
+#include "iota/conversion_kernels.h"
 
 #define NUM_RANDOM_TESTS 10000
 
@@ -45,6 +46,46 @@ static void test_increment_trit_no_overflow(void **state)
     assert_memory_equal(inc_trits, expected_trits, NUM_HASH_TRITS);
 }
 
+/** @brief Increments the tag area of the trits, the reference implementation.
+ */
+static void increment_trits_81(unsigned char *bytes)
+{
+    trit_t trits[NUM_HASH_TRITS];
+    bytes_to_trits(bytes, trits);
+    for (unsigned int i = 81; i < 162; i++) {
+        if (trits[i] < MAX_TRIT_VALUE) {
+            trits[i] += 1;
+            break;
+        }
+        trits[i] = MIN_TRIT_VALUE;
+    }
+    trits_to_bytes(trits, bytes);
+}
+
+static void test_increment_trit_random(void **state)
+{
+    UNUSED(state);
+
+    srand(2);
+    for (unsigned int i = 0; i < 1000; i++) {
+        trit_t trits[NUM_HASH_TRITS];
+        for (unsigned int j = 0; j < NUM_HASH_TRITS; j++) {
+            trits[j] = rand() % 3 - 1;
+        }
+        // mostly +1 in the tag area to also cover long carries and overflows
+        const unsigned int num_max = rand() % 82;
+        memset(trits + 81 + (81 - num_max), 1, num_max);
+
+        unsigned char bytes[NUM_HASH_BYTES], expected[NUM_HASH_BYTES];
+        trits_to_bytes(trits, bytes);
+        memcpy(expected, bytes, NUM_HASH_BYTES);
+
+        increment_trits_81(expected);
+        bytes_increment_trit_area_81(bytes);
+        assert_memory_equal(bytes, expected, NUM_HASH_BYTES);
+    }
+}
+
 static void test_int64_to_trits_zero(void **state)
 {
     UNUSED(state);
@@ -101,6 +142,84 @@ static void test_int64_to_trits_overflow(void **state)
     assert_true(result);
 }
 
+static void check_int64_round_trip(int64_t value)
+{
+    trit_t trits[81];
+    assert_false(int64_to_trits(value, trits, 81));
+
+    tryte_t trytes[27], expected_trytes[27];
+    assert_false(int64_to_trytes(value, trytes, 27));
+    trits_to_trytes(trits, expected_trytes, 81);
+    assert_memory_equal(trytes, expected_trytes, 27);
+
+    int64_t result = 0;
+    assert_false(trits_to_int64(trits, 81, &result));
+    assert_int_equal(result, value);
+
+    result = 0;
+    assert_false(trytes_to_int64(trytes, 27, &result));
+    assert_int_equal(result, value);
+
+    // an odd number of trits, which do not form whole trytes
+    result = 0;
+    assert_false(trits_to_int64(trits, 41, &result));
+    assert_int_equal(result, value);
+}
+
+static void test_int64_round_trip(void **state)
+{
+    UNUSED(state);
+
+    static const int64_t values[] = {0,
+                                     1,
+                                     -1,
+                                     13,
+                                     14,
+                                     -14,
+                                     MAX_IOTA_VALUE,
+                                     -MAX_IOTA_VALUE,
+                                     6078832729528464400,
+                                     INT64_MAX,
+                                     INT64_MIN,
+                                     INT64_MIN + 1};
+    for (unsigned int i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        check_int64_round_trip(values[i]);
+    }
+
+    srand(2);
+    for (unsigned int i = 0; i < NUM_RANDOM_TESTS; i++) {
+        check_int64_round_trip((int64_t)((uint64_t)rand() << 42 ^
+                                         (uint64_t)rand() << 21 ^ rand()));
+    }
+}
+
+static void test_trits_to_int64_overflow(void **state)
+{
+    UNUSED(state);
+
+    // 2^63, the negation of INT64_MIN
+    trit_t trits[81];
+    int64_to_trits(INT64_MIN, trits, 81);
+    for (unsigned int i = 0; i < 81; i++) {
+        trits[i] = -trits[i];
+    }
+
+    int64_t value = 42;
+    assert_true(trits_to_int64(trits, 81, &value));
+    assert_int_equal(value, 42);
+
+    tryte_t trytes[27];
+    trits_to_trytes(trits, trytes, 81);
+    assert_true(trytes_to_int64(trytes, 27, &value));
+
+    // the largest number with 40 trits fits, with 41 trits it does not
+    memset(trits, 1, 81);
+    assert_false(trits_to_int64(trits, 40, &value));
+    assert_int_equal(value, 6078832729528464400);
+    assert_true(trits_to_int64(trits, 41, &value));
+    assert_true(trits_to_int64(trits, 81, &value));
+}
+
 static void random_bytes(unsigned char *bytes)
 {
     for (int i = 0; i < NUM_HASH_BYTES; i++) {
@@ -108,6 +227,14 @@ static void random_bytes(unsigned char *bytes)
     }
 }
 
+static void random_trits(trit_t *trits)
+{
+    for (int i = 0; i < NUM_HASH_TRITS - 1; i++) {
+        trits[i] = rand() % 3 - 1;
+    }
+    trits[NUM_HASH_TRITS - 1] = 0;
+}
+
 static void random_chars(char *chars)
 {
     for (int i = 0; i < NUM_HASH_TRYTES; i++) {
@@ -215,17 +342,334 @@ static void test_random_chars_via_bytes(void **state)
     }
 }
 
+static void test_random_trytes_via_trits(void **state)
+{
+    UNUSED(state);
+
+    srand(2);
+    for (uint i = 0; i < NUM_RANDOM_TESTS; i++) {
+        char chars[NUM_HASH_TRYTES];
+        random_chars(chars);
+
+        tryte_t trytes[NUM_HASH_TRYTES];
+        chars_to_trytes(chars, trytes, NUM_HASH_TRYTES);
+
+        trit_t trits[NUM_HASH_TRITS];
+        trytes_to_trits(trytes, trits, NUM_HASH_TRYTES);
+        trits[242] = 0;
+
+        unsigned char bytes[NUM_HASH_BYTES], expected[NUM_HASH_BYTES];
+        trits_to_bytes(trits, expected);
+        trytes_to_bytes(trytes, bytes);
+        assert_memory_equal(bytes, expected, NUM_HASH_BYTES);
+
+        tryte_t expected_trytes[NUM_HASH_TRYTES];
+        bytes_to_trits(bytes, trits);
+        trits_to_trytes(trits, expected_trytes, NUM_HASH_TRITS);
+        bytes_to_trytes(bytes, trytes);
+        assert_memory_equal(trytes, expected_trytes, NUM_HASH_TRYTES);
+    }
+}
+
+static void test_random_batches(void **state)
+{
+    UNUSED(state);
+
+    // more chunks than converted at once, with a partial last batch
+    enum { MAX_CHUNKS = 11 };
+
+    srand(2);
+    for (unsigned int n = 0; n <= MAX_CHUNKS; n++) {
+        trit_t trits[MAX_CHUNKS * NUM_HASH_TRITS];
+        for (unsigned int i = 0; i < n; i++) {
+            random_trits(trits + i * NUM_HASH_TRITS);
+        }
+
+        unsigned char bytes[MAX_CHUNKS * NUM_HASH_BYTES];
+        unsigned char expected[MAX_CHUNKS * NUM_HASH_BYTES];
+        trits_to_bytes_n(trits, bytes, n);
+        for (unsigned int i = 0; i < n; i++) {
+            trits_to_bytes(trits + i * NUM_HASH_TRITS,
+                           expected + i * NUM_HASH_BYTES);
+        }
+        assert_memory_equal(bytes, expected, n * NUM_HASH_BYTES);
+
+        // arbitrary bytes, like the output of Keccak
+        for (unsigned int i = 0; i < n; i++) {
+            random_bytes(bytes + i * NUM_HASH_BYTES);
+        }
+
+        tryte_t trytes[MAX_CHUNKS * NUM_HASH_TRYTES];
+        tryte_t expected_trytes[MAX_CHUNKS * NUM_HASH_TRYTES];
+        bytes_to_trytes_n(bytes, trytes, n);
+        for (unsigned int i = 0; i < n; i++) {
+            bytes_to_trytes(bytes + i * NUM_HASH_BYTES,
+                            expected_trytes + i * NUM_HASH_TRYTES);
+        }
+        assert_memory_equal(trytes, expected_trytes, n * NUM_HASH_TRYTES);
+    }
+}
+
+static void test_packed_bytes(void **state)
+{
+    UNUSED(state);
+
+    // every valid byte decodes into its non-balanced trits and back
+    for (unsigned int byte = 0; byte < 243; byte++) {
+        const unsigned char packed = byte;
+        trit_t trits[TRITS_PER_PACKED_BYTE];
+        assert_int_equal(packed_to_trits(&packed, trits, 5), 0);
+
+        unsigned int value = 0;
+        for (unsigned int i = TRITS_PER_PACKED_BYTE; i-- > 0;) {
+            value = value * 3 + (trits[i] + 1);
+        }
+        assert_int_equal(value, byte);
+
+        unsigned char repacked;
+        trits_to_packed(trits, &repacked, 5);
+        assert_int_equal(repacked, byte);
+    }
+
+    for (unsigned int byte = 243; byte <= 0xFF; byte++) {
+        const unsigned char packed = byte;
+        trit_t trits[TRITS_PER_PACKED_BYTE];
+        assert_int_equal(packed_to_trits(&packed, trits, 5), -1);
+    }
+}
+
+static void test_random_packed(void **state)
+{
+    UNUSED(state);
+
+    srand(2);
+    for (unsigned int num_trytes = 0; num_trytes <= NUM_HASH_TRYTES;
+         num_trytes++) {
+        char chars[NUM_HASH_TRYTES];
+        random_chars(chars);
+
+        tryte_t trytes[NUM_HASH_TRYTES];
+        trit_t trits[NUM_HASH_TRITS];
+        chars_to_trytes(chars, trytes, num_trytes);
+        trytes_to_trits(trytes, trits, num_trytes);
+
+        // packing the trytes must be identical to packing their trits
+        unsigned char packed[NUM_PACKED_BYTES(NUM_HASH_TRITS)];
+        unsigned char expected[NUM_PACKED_BYTES(NUM_HASH_TRITS)];
+        trits_to_packed(trits, expected, num_trytes * 3);
+        trytes_to_packed(trytes, packed, num_trytes);
+        assert_memory_equal(packed, expected, NUM_PACKED_BYTES(num_trytes * 3));
+
+        trit_t unpacked_trits[NUM_HASH_TRITS];
+        assert_int_equal(
+            packed_to_trits(packed, unpacked_trits, num_trytes * 3), 0);
+        assert_memory_equal(unpacked_trits, trits, num_trytes * 3);
+
+        tryte_t unpacked_trytes[NUM_HASH_TRYTES];
+        assert_int_equal(
+            packed_to_trytes(packed, unpacked_trytes, num_trytes), 0);
+        assert_memory_equal(unpacked_trytes, trytes, num_trytes);
+    }
+}
+
+#define STREAM_CHUNKS 4
+
+/* Returns the encoding of the given ternary data in the given format. */
+static const void *stream_data(TERNARY_FORMAT format, const char *chars,
+                               const tryte_t *trytes, const trit_t *trits)
+{
+    switch (format) {
+    case TERNARY_TRITS:
+        return trits;
+    case TERNARY_TRYTES:
+        return trytes;
+    default:
+        return chars;
+    }
+}
+
+static void test_random_stream(void **state)
+{
+    UNUSED(state);
+
+    const unsigned int num_trytes = STREAM_CHUNKS * NUM_HASH_TRYTES;
+
+    srand(5);
+    for (uint i = 0; i < NUM_RANDOM_TESTS; i++) {
+        char chars[STREAM_CHUNKS * NUM_HASH_TRYTES];
+        for (uint j = 0; j < STREAM_CHUNKS; j++) {
+            random_chars(chars + j * NUM_HASH_TRYTES);
+        }
+        tryte_t trytes[STREAM_CHUNKS * NUM_HASH_TRYTES];
+        chars_to_trytes(chars, trytes, num_trytes);
+        trit_t trits[STREAM_CHUNKS * NUM_HASH_TRITS];
+        chars_to_trits(chars, trits, num_trytes);
+
+        for (int in = TERNARY_TRITS; in <= TERNARY_CHARS; in++) {
+            for (int out = TERNARY_TRITS; out <= TERNARY_CHARS; out++) {
+                const unsigned char *src =
+                    stream_data(in, chars, trytes, trits);
+                const unsigned int len =
+                    in == TERNARY_TRITS ? 3 * num_trytes : num_trytes;
+
+                TERNARY_STREAM ctx;
+                ternary_stream_initialize(&ctx, in, out);
+
+                // write the input in random pieces crossing the tryte blocks
+                unsigned char result[STREAM_CHUNKS * NUM_HASH_TRITS];
+                unsigned int written = 0;
+                for (unsigned int j = 0; j < len;) {
+                    const unsigned int n = MIN(len - j, rand() % 200);
+                    const unsigned int max = ternary_stream_output_len(&ctx, n);
+                    const unsigned int w = ternary_stream_write(
+                        &ctx, src + j, n, result + written);
+                    assert_true(w <= max);
+                    written += w;
+                    j += n;
+                }
+                written += ternary_stream_finalize(&ctx, result + written);
+
+                assert_int_equal(written, out == TERNARY_TRITS
+                                              ? 3 * num_trytes
+                                              : num_trytes);
+                assert_memory_equal(result,
+                                    stream_data(out, chars, trytes, trits),
+                                    written);
+            }
+        }
+    }
+}
+
+static void test_stream_padding(void **state)
+{
+    UNUSED(state);
+
+    const trit_t trits[] = {1, 1, 1, -1};
+    char chars[2];
+
+    TERNARY_STREAM ctx;
+    ternary_stream_initialize(&ctx, TERNARY_TRITS, TERNARY_CHARS);
+    assert_int_equal(ternary_stream_write(&ctx, trits, 2, chars), 0);
+    assert_int_equal(ternary_stream_write(&ctx, trits + 2, 2, chars), 1);
+    assert_int_equal(ternary_stream_finalize(&ctx, chars + 1), 1);
+    assert_memory_equal(chars, "MZ", 2);
+
+    // the finalized context can be reused
+    assert_int_equal(ternary_stream_finalize(&ctx, chars), 0);
+    assert_int_equal(ternary_stream_write(&ctx, trits, 3, chars), 1);
+    assert_int_equal(chars[0], 'M');
+}
+
+static void test_last_trit_zero_bounds(void **state)
+{
+    UNUSED(state);
+
+    // the most significant words around HALF_3 and NEG_HALF_3
+    static const uint32_t msws[] = {0x5e69ebee, 0x5e69ebef, 0x5e69ebf0,
+                                    0xa196140f, 0xa1961410, 0xa1961411};
+
+    for (unsigned int i = 0; i < sizeof(msws) / sizeof(msws[0]); i++) {
+        for (unsigned int fill = 0; fill <= 0xFF; fill += 0xFF) {
+            unsigned char bytes[NUM_HASH_BYTES], expected[NUM_HASH_BYTES];
+            memset(bytes, fill, NUM_HASH_BYTES);
+            bytes[0] = msws[i] >> 24;
+            bytes[1] = msws[i] >> 16;
+            bytes[2] = msws[i] >> 8;
+            bytes[3] = msws[i];
+            memcpy(expected, bytes, NUM_HASH_BYTES);
+
+            bytes_set_last_trit_zero_generic(expected);
+            bytes_set_last_trit_zero(bytes);
+            assert_memory_equal(bytes, expected, NUM_HASH_BYTES);
+        }
+    }
+}
+
+/** @brief Changes the big-endian integer by +/-1 and checks the result. */
+static void check_last_trit_zero_offset(const unsigned char *threshold,
+                                        int offset)
+{
+    unsigned char bytes[NUM_HASH_BYTES], expected[NUM_HASH_BYTES];
+    memcpy(bytes, threshold, NUM_HASH_BYTES);
+
+    for (unsigned int i = NUM_HASH_BYTES; i-- > 0;) {
+        const unsigned char old = bytes[i];
+        bytes[i] += offset;
+        // stop unless there was a carry or borrow
+        if ((offset > 0 && bytes[i] > old) || (offset < 0 && bytes[i] < old)) {
+            break;
+        }
+    }
+    memcpy(expected, bytes, NUM_HASH_BYTES);
+
+    bytes_set_last_trit_zero_generic(expected);
+    bytes_set_last_trit_zero(bytes);
+    assert_memory_equal(bytes, expected, NUM_HASH_BYTES);
+}
+
+static void test_last_trit_zero_thresholds(void **state)
+{
+    UNUSED(state);
+
+    for (int offset = -1; offset <= 1; offset++) {
+        check_last_trit_zero_offset(HALF_3_BYTES, offset);
+        check_last_trit_zero_offset(NEG_HALF_3_BYTES, offset);
+    }
+}
+
+/** @brief Checks bytes_increment() against bytes_add_u32_mem(). */
+static void check_increment(const unsigned char *bytes)
+{
+    unsigned char actual[NUM_HASH_BYTES], expected[NUM_HASH_BYTES];
+    memcpy(actual, bytes, NUM_HASH_BYTES);
+    memcpy(expected, bytes, NUM_HASH_BYTES);
+
+    bytes_increment(actual);
+    bytes_add_u32_mem(expected, 1);
+    assert_memory_equal(actual, expected, NUM_HASH_BYTES);
+}
+
+static void test_increment(void **state)
+{
+    UNUSED(state);
+
+    // the largest number wraps around, the smallest is just incremented
+    check_increment(HALF_3_BYTES);
+    check_increment(NEG_HALF_3_BYTES);
+
+    srand(6);
+    for (uint i = 0; i < NUM_RANDOM_TESTS; i++) {
+        unsigned char bytes[NUM_HASH_BYTES];
+        random_bytes(bytes);
+        // carry over several bytes
+        memset(bytes + NUM_HASH_BYTES - i % 8, 0xFF, i % 8);
+        check_increment(bytes);
+    }
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_increment_trit_82),
         cmocka_unit_test(test_increment_trit_no_overflow),
+        cmocka_unit_test(test_increment_trit_random),
         cmocka_unit_test(test_int64_to_trits_zero),
         cmocka_unit_test(test_int64_to_trits_one),
         cmocka_unit_test(test_int64_to_trits_neg_one),
         cmocka_unit_test(test_int64_to_trits_overflow),
         cmocka_unit_test(test_all_zero),
         cmocka_unit_test(test_all_neg_one),
+        cmocka_unit_test(test_random_trytes_via_trits),
+        cmocka_unit_test(test_int64_round_trip),
+        cmocka_unit_test(test_trits_to_int64_overflow),
+        cmocka_unit_test(test_random_batches),
+        cmocka_unit_test(test_packed_bytes),
+        cmocka_unit_test(test_random_packed),
+        cmocka_unit_test(test_random_stream),
+        cmocka_unit_test(test_stream_padding),
+        cmocka_unit_test(test_last_trit_zero_bounds),
+        cmocka_unit_test(test_last_trit_zero_thresholds),
+        cmocka_unit_test(test_increment),
         cmocka_unit_test(test_random_bytes_via_chars),
         cmocka_unit_test(test_random_chars_via_bytes)};
 
@@ -0,0 +1,212 @@
+#include "test_common.h"
+#include <stdlib.h>
+#include "iota/conversion_kernels.h"
+#include "iota/dispatch.h"
+
+#define NUM_RANDOM_TESTS 1000
+
+static const char *const BACKENDS[] = {"avx2", "avx512"};
+
+#define NUM_BACKENDS (sizeof(BACKENDS) / sizeof(BACKENDS[0]))
+
+static void random_trits(trit_t *trits)
+{
+    for (unsigned int i = 0; i < NUM_HASH_TRITS - 1; i++) {
+        trits[i] = rand() % 3 - 1;
+    }
+    trits[NUM_HASH_TRITS - 1] = 0;
+}
+
+static void random_words(uint64_t *words, unsigned int num_words)
+{
+    for (unsigned int i = 0; i < num_words; i++) {
+        words[i] = (uint64_t)rand() << 42 ^ (uint64_t)rand() << 21 ^ rand();
+    }
+}
+
+static void test_select_unknown(void **state)
+{
+    UNUSED(state);
+
+    const BACKEND *const selected = dispatch;
+
+    assert_false(dispatch_is_supported("unknown"));
+    assert_false(dispatch_select("unknown"));
+    assert_ptr_equal(dispatch, selected);
+
+    assert_true(dispatch_is_supported("generic"));
+}
+
+/** @brief Compares the permutations of a backend with the generic ones. */
+static void compare_permutation(void (*permutation)(uint64_t *),
+                                void (*generic)(uint64_t *),
+                                unsigned int lanes)
+{
+    uint64_t input[25 * 8], expected[25 * 8];
+
+    for (unsigned int i = 0; i < 10; i++) {
+        random_words(input, 25 * lanes);
+
+        memcpy(expected, input, 25 * lanes * sizeof(input[0]));
+        generic(expected);
+
+        permutation(input);
+        assert_memory_equal(input, expected, 25 * lanes * sizeof(input[0]));
+    }
+}
+
+static void test_keccak_scalar_permutations(void **state)
+{
+    UNUSED(state);
+
+    compare_permutation(sha3_permutation_unrolled, sha3_permutation_compact,
+                        1);
+    compare_permutation(sha3_permutation_interleaved32,
+                        sha3_permutation_compact, 1);
+}
+
+static void test_keccak_permutations(void **state)
+{
+    UNUSED(state);
+
+    for (unsigned int i = 0; i < NUM_BACKENDS; i++) {
+        if (!dispatch_select(BACKENDS[i])) {
+            continue;
+        }
+
+        compare_permutation(dispatch->keccak_permutation, sha3_permutation,
+                            1);
+        compare_permutation(dispatch->keccak_permutation_x2,
+                            sha3_permutation_x2, 2);
+        compare_permutation(dispatch->keccak_permutation_x4,
+                            sha3_permutation_x4, 4);
+        compare_permutation(dispatch->keccak_permutation_x8,
+                            sha3_permutation_x8, 8);
+    }
+}
+
+static void test_conversions(void **state)
+{
+    UNUSED(state);
+
+    for (unsigned int i = 0; i < NUM_BACKENDS; i++) {
+        if (!dispatch_select(BACKENDS[i])) {
+            continue;
+        }
+
+        for (unsigned int j = 0; j < NUM_RANDOM_TESTS; j++) {
+            trit_t trits[NUM_HASH_TRITS], expected_trits[NUM_HASH_TRITS];
+            random_trits(trits);
+
+            unsigned char bytes[NUM_HASH_BYTES], expected[NUM_HASH_BYTES];
+            trits_to_bytes_generic(trits, expected);
+            dispatch->trits_to_bytes(trits, bytes);
+            assert_memory_equal(bytes, expected, NUM_HASH_BYTES);
+
+            bytes_to_trits_generic(bytes, expected_trits);
+            dispatch->bytes_to_trits(bytes, trits);
+            assert_memory_equal(trits, expected_trits, NUM_HASH_TRITS);
+
+            tryte_t trytes[NUM_HASH_TRYTES], expected_trytes[NUM_HASH_TRYTES];
+            bytes_to_trytes_generic(bytes, expected_trytes);
+            dispatch->bytes_to_trytes(bytes, trytes);
+            assert_memory_equal(trytes, expected_trytes, NUM_HASH_TRYTES);
+
+            trytes_to_bytes_generic(trytes, expected);
+            dispatch->trytes_to_bytes(trytes, bytes);
+            assert_memory_equal(bytes, expected, NUM_HASH_BYTES);
+
+            // the batch kernels with one full and one partial batch
+            trit_t chunk_trits[5 * NUM_HASH_TRITS];
+            unsigned char chunk_bytes[5 * NUM_HASH_BYTES];
+            unsigned char expected_bytes[5 * NUM_HASH_BYTES];
+            for (unsigned int k = 0; k < 5; k++) {
+                random_trits(chunk_trits + k * NUM_HASH_TRITS);
+            }
+            trits_to_bytes_n_generic(chunk_trits, expected_bytes, 5);
+            dispatch->trits_to_bytes_n(chunk_trits, chunk_bytes, 5);
+            assert_memory_equal(chunk_bytes, expected_bytes,
+                                sizeof(chunk_bytes));
+
+            tryte_t chunk_trytes[5 * NUM_HASH_TRYTES];
+            tryte_t expected_chunk_trytes[5 * NUM_HASH_TRYTES];
+            bytes_to_trytes_n_generic(chunk_bytes, expected_chunk_trytes, 5);
+            dispatch->bytes_to_trytes_n(chunk_bytes, chunk_trytes, 5);
+            assert_memory_equal(chunk_trytes, expected_chunk_trytes,
+                                sizeof(chunk_trytes));
+
+            const uint32_t summand = rand();
+            bytes_add_u32_mem_generic(expected, summand);
+            dispatch->bytes_add_u32_mem(bytes, summand);
+            assert_memory_equal(bytes, expected, NUM_HASH_BYTES);
+
+            bytes_increment_trit_area_81_generic(expected);
+            dispatch->bytes_increment_trit_area_81(bytes);
+            assert_memory_equal(bytes, expected, NUM_HASH_BYTES);
+
+            // arbitrary bytes, like the output of Keccak
+            uint64_t words[NUM_HASH_BYTES / 8];
+            random_words(words, NUM_HASH_BYTES / 8);
+            memcpy(bytes, words, NUM_HASH_BYTES);
+            memcpy(expected, words, NUM_HASH_BYTES);
+            bytes_set_last_trit_zero_generic(expected);
+            dispatch->bytes_set_last_trit_zero(bytes);
+            assert_memory_equal(bytes, expected, NUM_HASH_BYTES);
+        }
+    }
+}
+
+static void test_char_conversions(void **state)
+{
+    UNUSED(state);
+
+    static const char ALPHABET[] = "9ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    for (unsigned int i = 0; i < NUM_BACKENDS; i++) {
+        if (!dispatch_select(BACKENDS[i])) {
+            continue;
+        }
+
+        for (unsigned int j = 0; j < NUM_RANDOM_TESTS; j++) {
+            const unsigned int len = rand() % 200;
+            char chars[200], expected_chars[200];
+            tryte_t trytes[200], expected_trytes[200];
+
+            // arbitrary chars, including invalid ones
+            for (unsigned int k = 0; k < len; k++) {
+                chars[k] = rand();
+            }
+            chars_to_trytes_generic(chars, expected_trytes, len);
+            dispatch->chars_to_trytes(chars, trytes, len);
+            assert_memory_equal(trytes, expected_trytes, len);
+
+            // valid chars
+            for (unsigned int k = 0; k < len; k++) {
+                chars[k] = ALPHABET[rand() % 27];
+            }
+            chars_to_trytes_generic(chars, trytes, len);
+            trytes_to_chars_generic(trytes, expected_chars, len);
+            dispatch->trytes_to_chars(trytes, chars, len);
+            assert_memory_equal(chars, expected_chars, len);
+
+            // at most one invalid char
+            if (len > 0 && rand() % 2) {
+                chars[rand() % len] = "@[8:`{\0"[rand() % 7];
+            }
+            assert_int_equal(dispatch->validate_chars(chars, len),
+                             validate_chars_generic(chars, len));
+        }
+    }
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_select_unknown),
+        cmocka_unit_test(test_keccak_scalar_permutations),
+        cmocka_unit_test(test_keccak_permutations),
+        cmocka_unit_test(test_conversions),
+        cmocka_unit_test(test_char_conversions)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -14,7 +14,7 @@ static void kerl(const char *input, const size_t squeeze_num_trits,
     unsigned char bytes[MAX_NUM_BYTES];
     chars_to_bytes(input, bytes, num_trytes);
 
-    cx_sha3_t kerl;
+    KERL_CTX kerl;
 
     kerl_initialize(&kerl);
     kerl_absorb_bytes(&kerl, bytes, NUM_BYTES(num_trits));
@@ -150,6 +150,373 @@ static void test_generate_trytes_and_multi_squeeze(void **state)
     test_for_each_line("generateTrytesAndMultiSqueeze", test);
 }
 
+static const char *const LANE_INPUTS[] = {
+    "PETERPETERPETERPETERPETERPETERPETERPETERPETERPETERPETERPETERPETERPETER"
+    "PETERPETERR",
+    "NNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNN"
+    "NNNNNNNNNNN",
+    "EMIDYNHBWMBCXVDEFOFWINXTERALUKYYPPHKP9JJFGJEIUY9MUDVNFZHMMWZUYUSWAIOWE"
+    "VTHNWMHANBH",
+    "9MIDYNHBWMBCXVDEFOFWINXTERALUKYYPPHKP9JJFGJEIUY9MUDVNFZHMMWZUYUSWAIOWE"
+    "VTHNWMHANBH",
+    "G9JYBOMPUXHYHKSNRNMMSSZCSHOFYOYNZRSZMAAYWDYEIMVVOGKPJBVBM9TDPULSFUNMTV"
+    "XRKFIDOHUXXVYDLFSZYZTWQYTE9SPYYWYTXJYQ9IFGYOLZXWZBKWZN9QOOTBQMWMUBLEWU"
+    "EEASRHRTNIQWJQNDWRYLCA"};
+
+#define NUM_LANE_INPUTS (sizeof(LANE_INPUTS) / sizeof(LANE_INPUTS[0]))
+
+/** @brief Writes num_chunks 48-byte chunks for each lane into bytes.
+ *  Lane j gets its chunks from the test inputs, starting at input j.
+ */
+static void lane_input_bytes(unsigned int lanes, unsigned int num_chunks,
+                             unsigned char *bytes)
+{
+    for (unsigned int j = 0; j < lanes; j++) {
+        for (unsigned int i = 0; i < num_chunks; i++) {
+            chars_to_bytes(LANE_INPUTS[(i + j) % NUM_LANE_INPUTS],
+                           bytes + (i * lanes + j) * NUM_HASH_BYTES,
+                           NUM_HASH_TRYTES);
+        }
+    }
+}
+
+/** @brief Computes the expected hash of lane j using the scalar Kerl. */
+static void lane_expected_hash(unsigned int lanes, unsigned int num_chunks,
+                               const unsigned char *bytes, unsigned int j,
+                               unsigned char *hash)
+{
+    KERL_CTX kerl;
+
+    kerl_initialize(&kerl);
+    for (unsigned int i = 0; i < num_chunks; i++) {
+        kerl_absorb_chunk(&kerl, bytes + (i * lanes + j) * NUM_HASH_BYTES);
+    }
+    kerl_squeeze_final_chunk(&kerl, hash);
+}
+
+/** @brief Absorbs num_chunks interleaved chunks into a multi-lane context and
+ *         squeezes num_squeezes interleaved chunks, the last one being final.
+ *  There is one such function per lane count, so that the tests below can be
+ *  shared between them.
+ */
+typedef void (*hash_lanes_fn)(const unsigned char *bytes,
+                              unsigned int num_chunks,
+                              unsigned int num_squeezes,
+                              unsigned char *hashes);
+
+static void hash_lanes_x2(const unsigned char *bytes, unsigned int num_chunks,
+                          unsigned int num_squeezes, unsigned char *hashes)
+{
+    const unsigned int stride = KERL_X2_LANES * NUM_HASH_BYTES;
+
+    KERL_CTX_X2 kerl;
+    kerl_initialize_x2(&kerl);
+    for (unsigned int i = 0; i < num_chunks; i++) {
+        kerl_absorb_chunk_x2(&kerl, bytes + i * stride);
+    }
+    for (unsigned int k = 0; k < num_squeezes - 1; k++) {
+        kerl_squeeze_chunk_x2(&kerl, hashes + k * stride);
+    }
+    kerl_squeeze_final_chunk_x2(&kerl, hashes + (num_squeezes - 1) * stride);
+}
+
+static void hash_lanes_x4(const unsigned char *bytes, unsigned int num_chunks,
+                          unsigned int num_squeezes, unsigned char *hashes)
+{
+    const unsigned int stride = KERL_X4_LANES * NUM_HASH_BYTES;
+
+    KERL_CTX_X4 kerl;
+    kerl_initialize_x4(&kerl);
+    for (unsigned int i = 0; i < num_chunks; i++) {
+        kerl_absorb_chunk_x4(&kerl, bytes + i * stride);
+    }
+    for (unsigned int k = 0; k < num_squeezes - 1; k++) {
+        kerl_squeeze_chunk_x4(&kerl, hashes + k * stride);
+    }
+    kerl_squeeze_final_chunk_x4(&kerl, hashes + (num_squeezes - 1) * stride);
+}
+
+static void hash_lanes_x8(const unsigned char *bytes, unsigned int num_chunks,
+                          unsigned int num_squeezes, unsigned char *hashes)
+{
+    const unsigned int stride = KERL_X8_LANES * NUM_HASH_BYTES;
+
+    KERL_CTX_X8 kerl;
+    kerl_initialize_x8(&kerl);
+    for (unsigned int i = 0; i < num_chunks; i++) {
+        kerl_absorb_chunk_x8(&kerl, bytes + i * stride);
+    }
+    for (unsigned int k = 0; k < num_squeezes - 1; k++) {
+        kerl_squeeze_chunk_x8(&kerl, hashes + k * stride);
+    }
+    kerl_squeeze_final_chunk_x8(&kerl, hashes + (num_squeezes - 1) * stride);
+}
+
+static void test_kerl_lanes(unsigned int lanes, hash_lanes_fn hash_lanes)
+{
+    for (unsigned int num_chunks = 1; num_chunks <= 5; num_chunks++) {
+        unsigned char bytes[5 * KERL_X8_LANES * NUM_HASH_BYTES];
+        lane_input_bytes(lanes, num_chunks, bytes);
+
+        unsigned char hashes[KERL_X8_LANES * NUM_HASH_BYTES];
+        hash_lanes(bytes, num_chunks, 1, hashes);
+
+        for (unsigned int j = 0; j < lanes; j++) {
+            unsigned char expected[NUM_HASH_BYTES];
+            lane_expected_hash(lanes, num_chunks, bytes, j, expected);
+
+            assert_memory_equal(hashes + j * NUM_HASH_BYTES, expected,
+                                NUM_HASH_BYTES);
+        }
+    }
+}
+
+static void test_kerl_x2(void **state)
+{
+    (void)state; // unused
+
+    test_kerl_lanes(KERL_X2_LANES, hash_lanes_x2);
+}
+
+static void test_kerl_x4(void **state)
+{
+    (void)state; // unused
+
+    test_kerl_lanes(KERL_X4_LANES, hash_lanes_x4);
+}
+
+static void test_kerl_x8(void **state)
+{
+    (void)state; // unused
+
+    test_kerl_lanes(KERL_X8_LANES, hash_lanes_x8);
+}
+
+// number of chunks squeezed from each lane, the last one being final
+#define NUM_LANE_SQUEEZES 4
+
+/** @brief Computes the chunks squeezed from each lane with a single-lane
+ *         context per lane. */
+static void lane_expected_squeezes(unsigned int lanes,
+                                   const unsigned char *bytes,
+                                   unsigned char *expected)
+{
+    for (unsigned int j = 0; j < lanes; j++) {
+        KERL_CTX kerl;
+        kerl_initialize(&kerl);
+        kerl_absorb_chunk(&kerl, bytes + j * NUM_HASH_BYTES);
+
+        for (unsigned int k = 0; k < NUM_LANE_SQUEEZES; k++) {
+            unsigned char *hash =
+                expected + (k * lanes + j) * NUM_HASH_BYTES;
+            if (k < NUM_LANE_SQUEEZES - 1) {
+                kerl_squeeze_chunk(&kerl, hash);
+            }
+            else {
+                kerl_squeeze_final_chunk(&kerl, hash);
+            }
+        }
+    }
+}
+
+static void test_kerl_squeeze_lanes(unsigned int lanes,
+                                    hash_lanes_fn hash_lanes)
+{
+    unsigned char bytes[KERL_X8_LANES * NUM_HASH_BYTES];
+    lane_input_bytes(lanes, 1, bytes);
+
+    unsigned char hashes[NUM_LANE_SQUEEZES * KERL_X8_LANES * NUM_HASH_BYTES];
+    hash_lanes(bytes, 1, NUM_LANE_SQUEEZES, hashes);
+
+    unsigned char expected[sizeof(hashes)];
+    lane_expected_squeezes(lanes, bytes, expected);
+    assert_memory_equal(hashes, expected,
+                        NUM_LANE_SQUEEZES * lanes * NUM_HASH_BYTES);
+}
+
+static void test_kerl_squeeze_x2(void **state)
+{
+    (void)state; // unused
+
+    test_kerl_squeeze_lanes(KERL_X2_LANES, hash_lanes_x2);
+}
+
+static void test_kerl_squeeze_x4(void **state)
+{
+    (void)state; // unused
+
+    test_kerl_squeeze_lanes(KERL_X4_LANES, hash_lanes_x4);
+}
+
+static void test_kerl_squeeze_x8(void **state)
+{
+    (void)state; // unused
+
+    test_kerl_squeeze_lanes(KERL_X8_LANES, hash_lanes_x8);
+}
+
+static void test_kerl_x4_peter_seed(void **state)
+{
+    (void)state; // unused
+
+    unsigned char bytes[KERL_X4_LANES * NUM_HASH_BYTES];
+    for (unsigned int j = 0; j < KERL_X4_LANES; j++) {
+        chars_to_bytes(LANE_INPUTS[0], bytes + j * NUM_HASH_BYTES,
+                       NUM_HASH_TRYTES);
+    }
+
+    KERL_CTX_X4 kerl;
+    kerl_initialize_x4(&kerl);
+    kerl_absorb_chunk_x4(&kerl, bytes);
+    kerl_squeeze_final_chunk_x4(&kerl, bytes);
+
+    for (unsigned int j = 0; j < KERL_X4_LANES; j++) {
+        char output[NUM_HASH_TRYTES + 1];
+        bytes_to_chars(bytes + j * NUM_HASH_BYTES, output, NUM_HASH_BYTES);
+        output[NUM_HASH_TRYTES] = '\0';
+
+        assert_string_equal(output, "JPXGSMTSWTIOVEMLNVWNUPDLZPCF9AARZTSBT9SUNTR"
+                                    "HIHWNVB9SPXFHWLY9OCSPLBELQGIFYDXG9OHOC");
+    }
+}
+
+static void test_kerl_hash_chunk(void **state)
+{
+    (void)state; // unused
+
+    for (unsigned int j = 0; j < NUM_LANE_INPUTS; j++) {
+        unsigned char bytes[NUM_HASH_BYTES];
+        chars_to_bytes(LANE_INPUTS[j], bytes, NUM_HASH_TRYTES);
+
+        unsigned char expected[NUM_HASH_BYTES];
+        lane_expected_hash(1, 1, bytes, 0, expected);
+
+        unsigned char hash[NUM_HASH_BYTES];
+        kerl_hash_chunk(bytes, hash);
+        assert_memory_equal(hash, expected, NUM_HASH_BYTES);
+
+        // hashing in place
+        kerl_hash_chunk(bytes, bytes);
+        assert_memory_equal(bytes, expected, NUM_HASH_BYTES);
+    }
+}
+
+static void test_kerl_absorb_unaligned(void **state)
+{
+    (void)state; // unused
+
+    unsigned char bytes[NUM_LANE_INPUTS * NUM_HASH_BYTES];
+    lane_input_bytes(1, NUM_LANE_INPUTS, bytes);
+
+    unsigned char expected[NUM_HASH_BYTES];
+    lane_expected_hash(1, NUM_LANE_INPUTS, bytes, 0, expected);
+
+    // absorb pieces crossing both the chunk and the block boundaries
+    static const unsigned int lengths[] = {1, 7, 40, 57, 3, 104, 28};
+
+    KERL_CTX kerl;
+    kerl_initialize(&kerl);
+    unsigned int offset = 0;
+    for (unsigned int i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        kerl_absorb_bytes(&kerl, bytes + offset, lengths[i]);
+        offset += lengths[i];
+    }
+    assert_int_equal(offset, sizeof(bytes));
+
+    unsigned char hash[NUM_HASH_BYTES];
+    kerl_squeeze_final_chunk(&kerl, hash);
+    assert_memory_equal(hash, expected, NUM_HASH_BYTES);
+}
+
+/** @brief Computes the expected hash chain using the Kerl context. */
+static void expected_chain(unsigned char *bytes, unsigned int n)
+{
+    for (unsigned int k = 0; k < n; k++) {
+        lane_expected_hash(1, 1, bytes, 0, bytes);
+    }
+}
+
+static void test_kerl_chain(void **state)
+{
+    (void)state; // unused
+
+    for (unsigned int n = 0; n <= 27; n++) {
+        unsigned char bytes[NUM_HASH_BYTES], expected[NUM_HASH_BYTES];
+        chars_to_bytes(LANE_INPUTS[n % NUM_LANE_INPUTS], bytes,
+                       NUM_HASH_TRYTES);
+        os_memcpy(expected, bytes, NUM_HASH_BYTES);
+
+        expected_chain(expected, n);
+        kerl_chain(bytes, n);
+        assert_memory_equal(bytes, expected, NUM_HASH_BYTES);
+    }
+}
+
+static void test_kerl_chain_lanes(unsigned int lanes,
+                                  void (*chain)(unsigned char *,
+                                                const unsigned int *))
+{
+    unsigned char bytes[KERL_X8_LANES * NUM_HASH_BYTES];
+    lane_input_bytes(lanes, 1, bytes);
+
+    // chains of different lengths, including an empty one
+    unsigned int num[KERL_X8_LANES];
+    for (unsigned int j = 0; j < lanes; j++) {
+        num[j] = (5 * j) % 27;
+    }
+
+    unsigned char expected[KERL_X8_LANES * NUM_HASH_BYTES];
+    os_memcpy(expected, bytes, lanes * NUM_HASH_BYTES);
+    for (unsigned int j = 0; j < lanes; j++) {
+        expected_chain(expected + j * NUM_HASH_BYTES, num[j]);
+    }
+
+    chain(bytes, num);
+    assert_memory_equal(bytes, expected, lanes * NUM_HASH_BYTES);
+}
+
+static void test_kerl_chain_x2(void **state)
+{
+    (void)state; // unused
+
+    test_kerl_chain_lanes(KERL_X2_LANES, kerl_chain_x2);
+}
+
+static void test_kerl_chain_x4(void **state)
+{
+    (void)state; // unused
+
+    test_kerl_chain_lanes(KERL_X4_LANES, kerl_chain_x4);
+}
+
+static void test_kerl_chain_x8(void **state)
+{
+    (void)state; // unused
+
+    test_kerl_chain_lanes(KERL_X8_LANES, kerl_chain_x8);
+}
+
+static void test_kerl_chain_n(void **state)
+{
+    (void)state; // unused
+
+    // all group sizes, including partial groups of every lane count
+    for (unsigned int num_chunks = 0; num_chunks <= 19; num_chunks++) {
+        unsigned char bytes[19 * NUM_HASH_BYTES], expected[19 * NUM_HASH_BYTES];
+        for (unsigned int j = 0; j < num_chunks; j++) {
+            chars_to_bytes(LANE_INPUTS[j % NUM_LANE_INPUTS],
+                           bytes + j * NUM_HASH_BYTES, NUM_HASH_TRYTES);
+        }
+        os_memcpy(expected, bytes, num_chunks * NUM_HASH_BYTES);
+
+        for (unsigned int j = 0; j < num_chunks; j++) {
+            kerl_chain(expected + j * NUM_HASH_BYTES, 3);
+        }
+        kerl_chain_n(bytes, num_chunks, 3);
+        assert_memory_equal(bytes, expected, num_chunks * NUM_HASH_BYTES);
+    }
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -161,7 +528,21 @@ int main(void)
         cmocka_unit_test(test_input_output_with_more_than_243trits),
         cmocka_unit_test(test_generate_trytes_and_hashes),
         cmocka_unit_test(test_generate_multi_trytes_and_hash),
-        cmocka_unit_test(test_generate_trytes_and_multi_squeeze)};
+        cmocka_unit_test(test_generate_trytes_and_multi_squeeze),
+        cmocka_unit_test(test_kerl_hash_chunk),
+        cmocka_unit_test(test_kerl_absorb_unaligned),
+        cmocka_unit_test(test_kerl_chain),
+        cmocka_unit_test(test_kerl_chain_x2),
+        cmocka_unit_test(test_kerl_chain_x4),
+        cmocka_unit_test(test_kerl_chain_x8),
+        cmocka_unit_test(test_kerl_chain_n),
+        cmocka_unit_test(test_kerl_squeeze_x2),
+        cmocka_unit_test(test_kerl_squeeze_x4),
+        cmocka_unit_test(test_kerl_squeeze_x8),
+        cmocka_unit_test(test_kerl_x2),
+        cmocka_unit_test(test_kerl_x4),
+        cmocka_unit_test(test_kerl_x4_peter_seed),
+        cmocka_unit_test(test_kerl_x8)};
 
     return cmocka_run_group_tests(tests, NULL, NULL);
 }